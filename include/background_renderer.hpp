@@ -0,0 +1,62 @@
+#pragma once
+#ifndef BE_CTABLE_BACKGROUND_RENDERER_HPP_
+#define BE_CTABLE_BACKGROUND_RENDERER_HPP_
+
+#include "table.hpp"
+#include "pending_table.hpp"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Lays out, renders, and encodes tables on a worker thread, so that
+///        the thread which submits a table only pays for the snapshot.
+///
+/// \details The worker renders into a back buffer, then swaps it with the
+///         front buffer, which the consumer collects with take() or
+///         write().  Buffers are recycled rather than copied, and a table
+///         submitted before the previous one has been rendered replaces it.
+///         Each line of a frame ends with a newline and is encoded as by
+///         LineEncoder.  There may be any number of producers, but only one
+///         consumer.
+class BackgroundRenderer final : Immovable {
+public:
+   explicit BackgroundRenderer(I32 max_total_width, const EncoderConfig& config = EncoderConfig());
+   ~BackgroundRenderer();
+
+   void submit(Table table);
+   void wait();
+
+   bool take(S& frame);
+   bool write(std::ostream& os);
+
+   U64 frames() const;
+   U64 coalesced() const;
+
+private:
+   void run_();
+
+   const I32 max_total_width_;
+   const LineEncoder encoder_;
+   LayoutCache layouts_; // worker only
+   S back_; // worker only
+   S out_; // consumer only
+
+   mutable std::mutex mutex_;
+   std::condition_variable cv_;
+   detail::PendingTable pending_;
+   S front_;
+   bool front_ready_;
+   bool busy_;
+   bool running_;
+   U64 frames_;
+
+   std::thread thread_;
+};
+
+} // be::ct
+
+#endif
@@ -12,6 +12,8 @@
 namespace be::ct {
 namespace detail {
 
+class LineProgramWriter;
+
 ///////////////////////////////////////////////////////////////////////////////
 template <typename Derived>
 class BaseRenderer : Immovable {
@@ -20,7 +22,10 @@ public:
       if (cached_width_ >= 0) {
          return cached_width_;
       } else {
-         return self_().width_();
+         if (memo_width_ < 0) {
+            memo_width_ = self_().width_();
+         }
+         return memo_width_;
       }
    }
 
@@ -28,26 +33,59 @@ public:
       if (cached_height_ >= 0) {
          return cached_height_;
       } else {
-         return self_().height_();
+         if (memo_height_ < 0) {
+            memo_height_ = self_().height_();
+         }
+         return memo_height_;
+      }
+   }
+
+   /// \brief Discards the memoized dimensions of this renderer and those
+   ///        containing it.  Must be called whenever anything that affects
+   ///        width_() or height_() changes.
+   void invalidate() {
+      if (memo_width_ >= 0 || memo_height_ >= 0) {
+         memo_width_ = -1;
+         memo_height_ = -1;
+         if (invalidate_parent_) {
+            invalidate_parent_(parent_);
+         }
       }
    }
 
+   /// \brief Registers the renderer which contains this one, so that it is
+   ///        invalidated along with this renderer.
+   template <typename Parent>
+   void parent(Parent& parent) {
+      parent_ = &parent;
+      invalidate_parent_ = [](void* ptr) {
+         static_cast<Parent*>(ptr)->invalidate();
+      };
+   }
+
    explicit operator bool() const {
       return line_ < height();
    }
 
    void freeze() {
-      self_().freeze_();
+      if (cached_width_ < 0 || cached_height_ < 0) {
+         self_().freeze_();
+      }
+   }
+
+   /// \brief Discards cached dimensions and rewinds to the first line so that
+   ///        the renderer can be resized and rendered again.
+   void thaw() {
+      self_().thaw_();
    }
 
    void operator()(std::ostream& os) {
-      freeze();
-      if (line_ < height()) {
-         self_().render_(os);
-         ++line_;
-      } else {
-         self_().render_blank_(os);
-      }
+      render_next_(os);
+   }
+
+   /// \brief Records the next line in a LineProgram instead of rendering it.
+   void operator()(LineProgramWriter& writer) {
+      render_next_(writer);
    }
 
 protected:
@@ -64,15 +102,37 @@ protected:
       }
    }
 
-   void render_(std::ostream& os) {
+   template <typename Stream>
+   void render_next_(Stream& os) {
+      freeze();
+      if (line_ < height()) {
+         self_().render_(os);
+         ++line_;
+      } else {
+         self_().render_blank_(os);
+      }
+   }
+
+   void thaw_() {
+      line_ = 0;
+      cached_width_ = -1;
+      cached_height_ = -1;
+      memo_width_ = -1;
+      memo_height_ = -1;
+   }
+
+   template <typename Stream>
+   void render_(Stream& os) {
       render_blank_(os);
    }
 
-   void render_blank_(std::ostream& os, I32 w) {
+   template <typename Stream>
+   void render_blank_(Stream& os, I32 w) {
       os << S((size_t)w, ' ');
    }
 
-   void render_blank_(std::ostream& os) {
+   template <typename Stream>
+   void render_blank_(Stream& os) {
       os << S((std::size_t)width(), ' ');
    }
 
@@ -86,6 +146,11 @@ protected:
    I32 cached_height_ = -1;
 
 private:
+   mutable I32 memo_width_ = -1;
+   mutable I32 memo_height_ = -1;
+   void* parent_ = nullptr;
+   void (*invalidate_parent_)(void*) = nullptr;
+
    Derived& self_() {
       return *static_cast<Derived*>(this);
    }
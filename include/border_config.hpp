@@ -24,6 +24,7 @@ struct BorderConfig {
 
 ///////////////////////////////////////////////////////////////////////////////
 std::vector<BorderChar> expand_border_pattern(const char* pattern, std::size_t width);
+void expand_border_pattern(const char* pattern, std::size_t width, std::vector<BorderChar>& out);
 
 } // be::ct
 
@@ -3,7 +3,7 @@
 #define BE_CTABLE_BORDER_RENDERER_HPP_
 
 #include "base_renderer.hpp"
-#include "border_config.hpp"
+#include "box_config.hpp"
 #include <be/core/console.hpp>
 
 namespace be::ct {
@@ -25,7 +25,9 @@ public:
         inside_line_(0),
         fg_(LogColor::current),
         bg_(LogColor::current)
-   { }
+   {
+      inner_.parent(*this);
+   }
 
    BorderRenderer(Inner& inner, vec_type top, vec_type right, vec_type bottom, vec_type left)
       : inner_(inner),
@@ -40,7 +42,9 @@ public:
         inside_line_(0),
         fg_(LogColor::current),
         bg_(LogColor::current)
-   { }
+   {
+      inner_.parent(*this);
+   }
 
    BorderRenderer(Inner& inner, vec_type top, vec_type right, vec_type bottom, vec_type left, LogColor fg, LogColor bg)
       : inner_(inner),
@@ -55,7 +59,9 @@ public:
         inside_line_(0),
         fg_(fg),
         bg_(bg)
-   { }
+   {
+      inner_.parent(*this);
+   }
 
    vec_type& top() { return top_; }
    vec_type& right() { return right_; }
@@ -72,7 +78,7 @@ public:
       throw std::invalid_argument("Unrecognized side!");
    }
 
-   bool enabled(BoxConfig::side side) {
+   bool enabled(BoxConfig::side side) const {
       switch (side) {
          case BoxConfig::top_side: return top_enabled_;
          case BoxConfig::right_side: return right_enabled_;
@@ -90,19 +96,37 @@ public:
          case BoxConfig::left_side: left_enabled_ = value; break;
          default: throw std::invalid_argument("Unrecognized side!");
       }
+      this->invalidate();
    }
 
    LogColor foreground() const { return fg_; }
-   void foreground(LogColor fg) {
-      fg_ = fg;
-   }
+   void foreground(LogColor fg) { fg_ = fg; }
 
    LogColor background() const { return bg_; }
-   void background(LogColor bg) {
-      bg_ = bg;
+   void background(LogColor bg) { bg_ = bg; }
+
+   /// \brief Groups each rule into runs of glyphs which share a color, and
+   ///        merges the box colors into the color of each glyph on either
+   ///        side, so that rendering a line doesn't examine each BorderChar.
+   ///
+   /// \details Called when this renderer is frozen.  Glyphs or colors
+   ///         changed after that (as by combine_border_corners()) are not
+   ///         drawn until prepare() is called again.
+   void prepare() {
+      prepare_rule_(top_, top_rule_);
+      prepare_rule_(bottom_, bottom_rule_);
+      prepare_side_(left_, left_side_);
+      prepare_side_(right_, right_side_);
    }
 
 private:
+   struct rule_run {
+      LogColorState color; // box colors merged in; LogColor::current is the line's base color
+      S text;
+   };
+
+   using rule_type = std::vector<rule_run>;
+
    I32 width_() const {
       return inner_.width()
          + (left_enabled_ ? 1 : 0)
@@ -118,80 +142,111 @@ private:
    void freeze_() {
       inner_.freeze();
       BaseRenderer<BorderRenderer<Inner>>::freeze_();
+      prepare();
+   }
+
+   void thaw_() {
+      inside_line_ = 0;
+      inner_.thaw();
+      BaseRenderer<BorderRenderer<Inner>>::thaw_();
    }
 
-   void render_(std::ostream& os) {
+   template <typename Stream>
+   void render_(Stream& os) {
       auto base_color = get_color(os);
 
       if (this->line_ == 0 && top_enabled_) {
-         render_rule_(os, top_);
+         render_rule_(os, top_rule_, base_color);
       } else if (this->line_ == this->height() - 1 && bottom_enabled_) {
-         render_rule_(os, bottom_);
+         render_rule_(os, bottom_rule_, base_color);
       } else {
-         render_side_(os, left_);
+         render_side_(os, left_side_);
          inner_(os);
-         render_side_(os, right_);
+         render_side_(os, right_side_);
          ++inside_line_;
       }
 
       os << base_color;
    }
 
-   void render_rule_(std::ostream& os, const vec_type& vec) {
-      os << setcolor(fg_, bg_);
-      auto initial_color = get_color(os);
-      auto color = initial_color;
+   BorderChar box_colored_(BorderChar bc) const {
+      if (bc.foreground == LogColor::current) {
+         bc.foreground = fg_;
+      }
+      if (bc.background == LogColor::current) {
+         bc.background = bg_;
+      }
+      return bc;
+   }
+
+   void prepare_rule_(const vec_type& vec, rule_type& rule) const {
+      rule.clear();
 
       if (left_enabled_) {
-         auto bc = vec.empty() ? BorderChar() : vec.front();
-         render_rule_char_(os, bc, color, initial_color);
+         add_rule_char_(rule, vec.empty() ? BorderChar() : vec.front());
       }
 
       for (int i = 0, w = inner_.width(); i < w; ++i) {
-         int index = i + 1;
-         if (index + 1 < vec.size()) {
-            render_rule_char_(os, vec[index], color, initial_color);
-         } else {
-            os << setcolor(fg_, bg_) << ' ';
-         }
+         std::size_t index = (std::size_t)i + 1;
+         add_rule_char_(rule, index + 1 < vec.size() ? vec[index] : BorderChar());
       }
 
       if (right_enabled_) {
-         auto bc = vec.empty() ? BorderChar() : vec.back();
-         render_rule_char_(os, bc, color, initial_color);
+         add_rule_char_(rule, vec.empty() ? BorderChar() : vec.back());
       }
    }
 
-   void render_rule_char_(std::ostream& os, BorderChar bc,
-                          LogColorState& color,
-                          LogColorState& initial_color) {
-      if (bc.foreground == LogColor::current) {
-         bc.foreground = initial_color.fg;
+   void add_rule_char_(rule_type& rule, const BorderChar& glyph) const {
+      BorderChar bc = box_colored_(glyph);
+      if (!rule.empty()) {
+         rule_run& run = rule.back();
+         if (run.color.fg == bc.foreground && run.color.bg == bc.background) {
+            run.text.push_back(bc.glyph);
+            return;
+         }
       }
+      rule.push_back({ LogColorState { bc.foreground, bc.background }, S(1, bc.glyph) });
+   }
 
-      if (bc.background == LogColor::current) {
-         bc.background = initial_color.bg;
+   /// \brief One glyph for each line of the inner renderer; lines past the
+   ///        end of the pattern are blank, in the box colors.
+   void prepare_side_(const vec_type& vec, vec_type& side) const {
+      side.clear();
+      if (!vec.empty()) {
+         std::size_t height = (std::size_t)std::max(0, inner_.height());
+         side.reserve(height);
+         for (std::size_t i = 0; i < height; ++i) {
+            side.push_back(box_colored_(i + 1 < vec.size() ? vec[i + 1] : BorderChar()));
+         }
       }
+   }
 
-      if (color.fg != bc.foreground || color.bg != bc.background) {
-         color.fg = bc.foreground;
-         color.bg = bc.background;
-         os << color;
-      }
+   template <typename Stream>
+   void render_rule_(Stream& os, const rule_type& rule, LogColorState base_color) {
+      LogColorState color = base_color;
+      for (const rule_run& run : rule) {
+         LogColorState run_color = run.color;
+         if (run_color.fg == LogColor::current) {
+            run_color.fg = base_color.fg;
+         }
+         if (run_color.bg == LogColor::current) {
+            run_color.bg = base_color.bg;
+         }
+
+         if (color.fg != run_color.fg || color.bg != run_color.bg) {
+            color = run_color;
+            os << color;
+         }
 
-      os << bc.glyph;
+         os << run.text;
+      }
    }
 
-   void render_side_(std::ostream& os, const vec_type& vec) {
-      if (!vec.empty()) {
-         os << setcolor(fg_, bg_);
-         I32 index = inside_line_ + 1;
-         if (index < vec.size()) {
-            auto bc = vec[index];
-            os << setcolor(bc.foreground, bc.background) << bc.glyph;
-         } else {
-            os << ' ';
-         }
+   template <typename Stream>
+   void render_side_(Stream& os, const vec_type& side) {
+      if (!side.empty()) {
+         const BorderChar& bc = side[inside_line_];
+         os << setcolor(bc.foreground, bc.background) << bc.glyph;
       }
    }
 
@@ -207,6 +262,10 @@ private:
    I32 inside_line_;
    LogColor fg_;
    LogColor bg_;
+   rule_type top_rule_;
+   rule_type bottom_rule_;
+   vec_type left_side_;
+   vec_type right_side_;
 };
 
 } // be::ct::detail
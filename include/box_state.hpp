@@ -0,0 +1,61 @@
+#pragma once
+#ifndef BE_CTABLE_BOX_STATE_HPP_
+#define BE_CTABLE_BOX_STATE_HPP_
+
+#include "box_config.hpp"
+
+namespace be::ct {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The margin outside a side's border; the border itself occupies the
+///        first unit of the configured margin.
+inline U8 border_margin(const BorderConfig& config) {
+   return config.margin > 0 ? config.margin - 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Border>
+void add_box_border(Border& border, const BoxConfig& config, BoxConfig::side side) {
+   if (config.sides[side].margin > 0) {
+      border.enabled(side, true);
+      border.top().emplace_back();
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Border>
+void add_box_borders(Border& border, const BoxConfig& config) {
+   add_box_border(border, config, BoxConfig::top_side);
+   add_box_border(border, config, BoxConfig::right_side);
+   add_box_border(border, config, BoxConfig::bottom_side);
+   add_box_border(border, config, BoxConfig::left_side);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Restores the margins, padding, and borders of a cell, row, or table
+///        renderer to what its BoxConfig specifies, undoing any trimming done
+///        by a previous auto_size().
+template <typename Box>
+void restore_box(Box& box, const BoxConfig& config) {
+   for (auto side : { BoxConfig::top_side, BoxConfig::right_side, BoxConfig::bottom_side, BoxConfig::left_side }) {
+      box.border.get(side).clear();
+      box.border.enabled(side, false);
+   }
+
+   box.margin.top(border_margin(config.sides[BoxConfig::top_side]));
+   box.margin.right(border_margin(config.sides[BoxConfig::right_side]));
+   box.margin.bottom(border_margin(config.sides[BoxConfig::bottom_side]));
+   box.margin.left(border_margin(config.sides[BoxConfig::left_side]));
+   box.padding.top(config.sides[BoxConfig::top_side].padding);
+   box.padding.right(config.sides[BoxConfig::right_side].padding);
+   box.padding.bottom(config.sides[BoxConfig::bottom_side].padding);
+   box.padding.left(config.sides[BoxConfig::left_side].padding);
+
+   add_box_borders(box.border, config);
+}
+
+} // be::ct::detail
+} // be::ct
+
+#endif
@@ -53,14 +53,18 @@ public:
    bool dirty() const;
    void clean() const;
 
+   U64 hash() const;
+
 private:
    void init_stream_() const;
+   void add_datum_(datum d) const;
 
    LogColor fg_;
    LogColor bg_;
    mutable stream_status stream_status_;
    mutable std::stringstream stream_;
    mutable data_container data_;
+   mutable U64 hash_; // of data_ only; updated as data is added
    CellConfig config_;
 };
 
@@ -0,0 +1,64 @@
+#pragma once
+#ifndef BE_CTABLE_CELL_OUTPUT_CACHE_HPP_
+#define BE_CTABLE_CELL_OUTPUT_CACHE_HPP_
+
+#include "line_program.hpp"
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Remembers the rendered lines of recently rendered cells, so that
+///        cells whose content, size, and alignment haven't changed since the
+///        previous frame don't need to be wrapped and formatted again.
+///
+/// \details Cells are identified by Cell::hash(), which changes whenever new
+///         data is added to a cell, so edited cells miss automatically.  The
+///         least recently used entries are discarded when full.
+class CellOutputCache final {
+public:
+   struct key {
+      U64 cell_hash;
+      I32 width;
+      I32 height;
+      U8 align;
+
+      friend bool operator==(const key& a, const key& b) {
+         return a.cell_hash == b.cell_hash && a.width == b.width && a.height == b.height && a.align == b.align;
+      }
+   };
+
+   using program_ptr = std::shared_ptr<const LineProgram>;
+
+   CellOutputCache();
+   explicit CellOutputCache(std::size_t capacity);
+
+   std::size_t capacity() const;
+   std::size_t size() const;
+   void clear();
+
+   U64 hits() const;
+   U64 misses() const;
+
+   program_ptr find(const key& k);
+   void insert(const key& k, program_ptr program);
+
+private:
+   struct key_hash {
+      std::size_t operator()(const key& k) const;
+   };
+
+   using entry_list = std::list<std::pair<key, program_ptr>>;
+
+   std::size_t capacity_;
+   entry_list entries_; // most recently used first
+   std::unordered_map<key, entry_list::iterator, key_hash> index_;
+   U64 hits_;
+   U64 misses_;
+};
+
+} // be::ct
+
+#endif
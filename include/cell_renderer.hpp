@@ -34,13 +34,28 @@ private:
    I32 height_() const;
 
    void freeze_();
-   void render_(std::ostream& os);
+   void thaw_();
+
+   template <typename Stream>
+   void render_(Stream& os) {
+      if (undecorated_) {
+         // nothing to draw around the text, but its colors must still be
+         // reset after each line, as margin would have done.
+         auto base_color = get_color(os);
+         text(os);
+         os << base_color;
+      } else {
+         margin(os);
+      }
+   }
+
+   bool is_undecorated_() const;
 
-   void try_add_border_(BoxConfig::side side);
    void generate_border_(BoxConfig::side side);
    void resolve_border_colors_(BoxConfig::side side);
 
    const BoxConfig& config_;
+   bool undecorated_;
 };
 
 } // be::ct::detail
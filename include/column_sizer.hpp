@@ -3,37 +3,46 @@
 #define BE_CTABLE_COLUMN_SIZER_HPP_
 
 #include "cell_renderer.hpp"
+#include "column_stats.hpp"
+#include "layout_snapshot.hpp"
 
 namespace be::ct {
 namespace detail {
 
 ///////////////////////////////////////////////////////////////////////////////
+/// \brief Streams the width requirements of a column's cells; cells are not
+///        retained, so apply() must be called for each one after set_widths().
+///        Measurements are not modified by set_widths(), so it may be called
+///        again with a different width.
 class ColumnSizer final {
 public:
-   using vec_type = std::vector<CellRenderer*>;
+   ColumnSizer();
+   explicit ColumnSizer(F32 pref_width_percentile);
 
-   ColumnSizer(std::size_t n_rows);
-
-   void add(CellRenderer& cell);
+   void add(const CellRenderer& cell);
+   void add(const ColumnStats& stats);
 
    void set_widths(I32 total_width);
+   void set_widths(const ColumnLayout& layout);
+   void apply(CellRenderer& cell) const;
+
+   ColumnLayout layout() const;
 
    I32 external_width() const;
    I32 pref_internal_width() const;
    I32 min_internal_width() const;
    I32 max_internal_width() const;
+   I32 internal_width() const;
 
 private:
-   vec_type cells_;
-   U16 left_external_width_;
-   U16 right_external_width_;
-   I32 pref_internal_width_;
-   I32 min_internal_width_;
-   I32 max_internal_width_;
+   ColumnStats stats_;
+   F32 pref_width_percentile_;
+   U16 left_external_;
+   U16 right_external_;
+   I32 internal_width_;
 };
 
 } // be::ct::detail
 } // be::ct
 
 #endif
-
@@ -0,0 +1,34 @@
+#pragma once
+#ifndef BE_CTABLE_COLUMN_STATS_HPP_
+#define BE_CTABLE_COLUMN_STATS_HPP_
+
+#include "width_sketch.hpp"
+#include <be/core/be.hpp>
+#include <limits>
+#include <vector>
+
+namespace be::ct {
+
+class Cell;
+class Row;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Aggregate width requirements of the cells in a table column.
+struct ColumnStats {
+   U16 left_external = 0;
+   U16 right_external = 0;
+   I32 pref_internal = 0;
+   I32 min_internal = 0;
+   I32 max_internal = std::numeric_limits<I32>::max();
+   WidthSketch pref_sketch; // only populated when a pref_width_percentile is in effect
+
+   void add(const ColumnStats& other);
+   I32 pref_internal_percentile(F32 percentile) const;
+};
+
+ColumnStats measure_cell(const Cell& cell);
+void add_column_stats(std::vector<ColumnStats>& stats, const Row& row, bool sketch);
+
+} // be::ct
+
+#endif
@@ -0,0 +1,230 @@
+#pragma once
+#ifndef BE_CTABLE_COMPILED_BORDER_PATTERN_HPP_
+#define BE_CTABLE_COMPILED_BORDER_PATTERN_HPP_
+
+#include "border_config.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace be::ct {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////
+constexpr bool is_hex_digit(char c) {
+   return (c >= '0' && c <= '9') ||
+      (c >= 'a' && c <= 'f') ||
+      (c >= 'A' && c <= 'F');
+}
+
+///////////////////////////////////////////////////////////////////////////////
+constexpr U8 hex_digit(char c) {
+   if (c >= '0' && c <= '9') {
+      return c - '0';
+   }
+
+   if (c >= 'a' && c <= 'f') {
+      return c - 'a' + 0xA;
+   }
+
+   if (c >= 'A' && c <= 'F') {
+      return c - 'A' + 0xA;
+   }
+
+   return 0;
+}
+
+} // be::ct::detail
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A border pattern which has been parsed into groups of BorderChars,
+///        so that expanding it is just a matter of filling each group's width.
+///
+/// \details When declared constexpr, the pattern is parsed at compile time,
+///         and malformed patterns (unterminated or mismatched groups,
+///         unmatched closing brackets, or incomplete escape sequences) fail to
+///         compile.  Well-formed patterns expand exactly as they would with
+///         expand_border_pattern(const char*, std::size_t).
+///
+///         constexpr CompiledBorderPattern rule("[+](-)[+]");
+template <std::size_t N>
+class CompiledBorderPattern final {
+public:
+   constexpr CompiledBorderPattern(const char (&pattern)[N])
+      : chars_ { },
+        groups_ { },
+        n_groups_(0),
+        fixed_width_(0),
+        expandable_groups_(0)
+   {
+      std::size_t n_chars = 0;
+      std::size_t i = 0;
+      while (!at_end_(pattern, i)) {
+         char ch = pattern[i];
+         group g = { n_chars, 0, 0, true };
+         BorderChar bc;
+
+         if (ch == '[' || ch == '(') {
+            char close = ch == '[' ? ']' : ')';
+            g.expandable = ch == '(';
+            ++i;
+
+            std::size_t depth = 0;
+            for (;;) {
+               if (at_end_(pattern, i)) {
+                  throw std::invalid_argument("Unterminated border pattern group!");
+               }
+
+               ch = pattern[i];
+               if (ch == '$') {
+                  i = parse_escape_(pattern, i, bc, g, n_chars);
+                  continue;
+               } else if (ch == '[' || ch == '(') {
+                  ++depth;
+               } else if (ch == ']' || ch == ')') {
+                  if (depth == 0) {
+                     if (ch != close) {
+                        throw std::invalid_argument("Mismatched border pattern group brackets!");
+                     }
+                     ++i;
+                     break;
+                  }
+                  --depth;
+               }
+
+               add_char_(bc, ch, g, n_chars);
+               ++i;
+            }
+         } else {
+            // implicit expandable group; continues until the next explicit group
+            while (!at_end_(pattern, i)) {
+               ch = pattern[i];
+               if (ch == '[' || ch == '(') {
+                  break;
+               } else if (ch == ']' || ch == ')') {
+                  throw std::invalid_argument("Unmatched closing bracket in border pattern!");
+               } else if (ch == '$') {
+                  i = parse_escape_(pattern, i, bc, g, n_chars);
+               } else {
+                  add_char_(bc, ch, g, n_chars);
+                  ++i;
+               }
+            }
+         }
+
+         g.length = g.width;
+         if (g.width == 0) {
+            // empty groups repeat a space, in whatever color was last specified
+            bc.glyph = ' ';
+            chars_[n_chars++] = bc;
+            g.length = 1;
+         }
+
+         if (g.expandable) {
+            ++expandable_groups_;
+         } else {
+            fixed_width_ += g.width;
+         }
+         groups_[n_groups_++] = g;
+      }
+   }
+
+   void expand(std::size_t width, std::vector<BorderChar>& out) const {
+      out.clear();
+      out.reserve(width);
+
+      std::size_t expandable_width = width - std::min(width, fixed_width_);
+      std::size_t expandable_dividend = expandable_groups_ > 0 ? expandable_width / expandable_groups_ : 0;
+      std::size_t expandable_remainder = expandable_groups_ > 0 ? expandable_width % expandable_groups_ : 0;
+
+      std::size_t expandable_group_num = 0;
+      for (std::size_t i = 0; i < n_groups_; ++i) {
+         const group& g = groups_[i];
+         std::size_t w = g.width;
+         if (g.expandable) {
+            ++expandable_group_num;
+            w = expandable_dividend;
+            if (expandable_group_num <= expandable_remainder) {
+               ++w;
+            }
+         }
+
+         for (std::size_t j = 0; j < w; ++j) {
+            out.push_back(chars_[g.offset + j % g.length]);
+         }
+      }
+
+      out.resize(width);
+   }
+
+   std::vector<BorderChar> expand(std::size_t width) const {
+      std::vector<BorderChar> results;
+      expand(width, results);
+      return results;
+   }
+
+private:
+   struct group {
+      std::size_t offset;
+      std::size_t width;  // glyphs in the pattern
+      std::size_t length; // chars_ repeated when filling; at least 1
+      bool expandable;
+   };
+
+   static constexpr bool at_end_(const char (&pattern)[N], std::size_t i) {
+      return i + 1 >= N || pattern[i] == '\0';
+   }
+
+   constexpr void add_char_(BorderChar& bc, char glyph, group& g, std::size_t& n_chars) {
+      bc.glyph = glyph;
+      chars_[n_chars++] = bc;
+      ++g.width;
+   }
+
+   constexpr std::size_t parse_escape_(const char (&pattern)[N], std::size_t i, BorderChar& bc, group& g, std::size_t& n_chars) {
+      if (at_end_(pattern, i + 1)) {
+         throw std::invalid_argument("Incomplete escape sequence in border pattern!");
+      }
+
+      char ch = pattern[i + 1];
+      if (ch == 'g') {
+         if (at_end_(pattern, i + 2) || !detail::is_hex_digit(pattern[i + 2])) {
+            throw std::invalid_argument("Expected hex digit after $g in border pattern!");
+         }
+         bc.foreground = static_cast<LogColor>(detail::hex_digit(pattern[i + 2]));
+         return i + 3;
+      } else if (ch == 'G') {
+         if (at_end_(pattern, i + 2) || !detail::is_hex_digit(pattern[i + 2]) ||
+             at_end_(pattern, i + 3) || !detail::is_hex_digit(pattern[i + 3])) {
+            throw std::invalid_argument("Expected two hex digits after $G in border pattern!");
+         }
+         bc.background = static_cast<LogColor>(detail::hex_digit(pattern[i + 2]));
+         bc.foreground = static_cast<LogColor>(detail::hex_digit(pattern[i + 3]));
+         return i + 4;
+      } else if (detail::is_hex_digit(ch)) {
+         if (at_end_(pattern, i + 2) || !detail::is_hex_digit(pattern[i + 2])) {
+            throw std::invalid_argument("Expected two hex digits in border pattern glyph escape!");
+         }
+         add_char_(bc, (char)(detail::hex_digit(ch) << 4 | detail::hex_digit(pattern[i + 2])), g, n_chars);
+         return i + 3;
+      }
+
+      add_char_(bc, ch, g, n_chars);
+      return i + 2;
+   }
+
+   BorderChar chars_[N];
+   group groups_[N];
+   std::size_t n_groups_;
+   std::size_t fixed_width_;
+   std::size_t expandable_groups_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <std::size_t N>
+std::vector<BorderChar> expand_border_pattern(const CompiledBorderPattern<N>& pattern, std::size_t width) {
+   return pattern.expand(width);
+}
+
+} // be::ct
+
+#endif
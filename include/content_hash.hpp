@@ -0,0 +1,43 @@
+#pragma once
+#ifndef BE_CTABLE_CONTENT_HASH_HPP_
+#define BE_CTABLE_CONTENT_HASH_HPP_
+
+#include "box_config.hpp"
+#include <type_traits>
+
+namespace be::ct {
+namespace detail {
+
+constexpr const U64 content_hash_basis = 14695981039346656037ull;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Folds bytes into a 64-bit FNV-1a hash.
+inline U64 hash_bytes(U64 hash, const void* data, std::size_t size) {
+   const U8* ptr = static_cast<const U8*>(data);
+   for (std::size_t i = 0; i < size; ++i) {
+      hash = (hash ^ ptr[i]) * 1099511628211ull;
+   }
+   return hash;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+U64 hash_value(U64 hash, T value) {
+   static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Only scalars can be hashed by value!");
+   return hash_bytes(hash, &value, sizeof(T));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Folds in the parts of a BoxConfig which affect sizing.
+inline U64 hash_box_config(U64 hash, const BoxConfig& config) {
+   for (const BorderConfig& side : config.sides) {
+      hash = hash_value(hash, side.margin);
+      hash = hash_value(hash, side.padding);
+   }
+   return hash;
+}
+
+} // be::ct::detail
+} // be::ct
+
+#endif
@@ -32,7 +32,8 @@ private:
    I32 width_() const { return w_; }
    I32 height_() const { return h_; }
 
-   void render_(std::ostream& os) {
+   template <typename Stream>
+   void render_(Stream& os) {
       auto base_color = get_color(os);
       os << setcolor(fg_, bg_);
       render_blank_(os);
@@ -0,0 +1,18 @@
+#pragma once
+#ifndef BE_CTABLE_ENCODER_CONFIG_HPP_
+#define BE_CTABLE_ENCODER_CONFIG_HPP_
+
+#include <be/core/be.hpp>
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+struct EncoderConfig {
+   bool color = true; // emit ANSI SGR sequences for color changes; plain text otherwise
+   bool trim_trailing_blanks = false; // drop blanks at the end of each line, unless they have a non-default background
+   U32 cursor_forward_threshold = 0; // runs of at least this many default-background blanks become CSI cursor forward sequences; 0 to disable
+};
+
+} // be::ct
+
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+#ifndef BE_CTABLE_FRAME_SCHEDULER_HPP_
+#define BE_CTABLE_FRAME_SCHEDULER_HPP_
+
+#include "table.hpp"
+#include "pending_table.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Draws the most recently submitted state of a live table to a
+///        stream, at most max_fps times per second.
+///
+/// \details Producers submit() snapshots of the table from any thread; a
+///         snapshot that hasn't been drawn yet is simply replaced, so
+///         intermediate states are coalesced and submit() never waits for
+///         output.  Frames are drawn by tick(), either called by the owner
+///         or from the scheduler's own thread after start().  Each frame is
+///         written with a single write() using LiveLayout and LiveDisplay, so
+///         only changed lines are redrawn.
+class FrameScheduler final : Immovable {
+public:
+   using clock = std::chrono::steady_clock;
+
+   explicit FrameScheduler(std::ostream& os, F64 max_fps = 30);
+   ~FrameScheduler();
+
+   void submit(Table table);
+   bool tick();
+
+   void start();
+   void stop();
+
+   U64 frames() const;
+   U64 coalesced() const;
+
+private:
+   void run_();
+
+   std::ostream& os_;
+   clock::duration min_interval_;
+   LiveLayout layout_;
+   LiveDisplay display_;
+
+   mutable std::mutex mutex_;
+   std::condition_variable cv_;
+   detail::PendingTable pending_;
+   clock::time_point next_frame_;
+   U64 frames_;
+   bool running_;
+
+   std::mutex draw_mutex_;
+   std::thread thread_;
+};
+
+} // be::ct
+
+#endif
@@ -21,15 +21,25 @@ public:
 
    HSeqRenderer(vec_type inner)
       : inner_(std::move(inner))
-   { }
+   {
+      for (auto ptr : inner_) {
+         ptr->parent(*this);
+      }
+   }
 
    template <typename I>
    HSeqRenderer(I begin, I end)
       : inner_(begin, end)
-   { }
+   {
+      for (auto ptr : inner_) {
+         ptr->parent(*this);
+      }
+   }
 
    void add(Inner* inner) {
       inner_.push_back(inner);
+      inner->parent(*this);
+      this->invalidate();
    }
 
 private:
@@ -54,7 +64,15 @@ private:
       BaseRenderer<HSeqRenderer<Inner>>::freeze_();
    }
 
-   void render_(std::ostream& os) {
+   void thaw_() {
+      for (auto ptr : inner_) {
+         ptr->thaw();
+      }
+      BaseRenderer<HSeqRenderer<Inner>>::thaw_();
+   }
+
+   template <typename Stream>
+   void render_(Stream& os) {
       for (auto ptr : inner_) {
          (*ptr)(os);
       }
@@ -0,0 +1,39 @@
+#pragma once
+#ifndef BE_CTABLE_LAYOUT_CACHE_HPP_
+#define BE_CTABLE_LAYOUT_CACHE_HPP_
+
+#include "layout_snapshot.hpp"
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Remembers the layouts of recently sized tables, keyed by
+///        Table::hash() and the width they were sized for, so that tables
+///        which are rebuilt with the same content don't need to be measured
+///        again.  The least recently used layout is discarded when full.
+class LayoutCache final {
+public:
+   LayoutCache();
+   explicit LayoutCache(std::size_t capacity);
+
+   std::size_t capacity() const;
+   std::size_t size() const;
+   void clear();
+
+   const LayoutSnapshot* find(U64 table_hash, I32 max_total_width);
+   void insert(U64 table_hash, I32 max_total_width, const LayoutSnapshot& layout);
+
+private:
+   struct entry {
+      U64 table_hash;
+      I32 max_total_width;
+      LayoutSnapshot layout;
+   };
+
+   std::size_t capacity_;
+   std::vector<entry> entries_; // most recently used first
+};
+
+} // be::ct
+
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+#ifndef BE_CTABLE_LAYOUT_SNAPSHOT_HPP_
+#define BE_CTABLE_LAYOUT_SNAPSHOT_HPP_
+
+#include <be/core/be.hpp>
+#include <vector>
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+struct ColumnLayout {
+   U16 left_external = 0; // margin + border
+   U16 right_external = 0;
+   I32 internal_width = 0; // padding + text
+};
+
+///////////////////////////////////////////////////////////////////////////////
+struct RowLayout {
+   U16 top_external = 0; // margin + border
+   U16 bottom_external = 0;
+   I32 internal_height = 0; // padding + text
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The result of sizing a table, which can be applied to later
+///        renders of a table with the same shape instead of sizing it again.
+///
+/// \details If rows is empty, only column widths are applied and row heights
+///         are recalculated.
+struct LayoutSnapshot {
+   U16 margin_left = 0;
+   U16 margin_right = 0;
+   U16 padding_left = 0;
+   U16 padding_right = 0;
+   U16 row_left_external = 0;
+   U16 row_right_external = 0;
+   U16 row_padding_left = 0;
+   U16 row_padding_right = 0;
+   std::vector<ColumnLayout> columns;
+   std::vector<RowLayout> rows;
+};
+
+} // be::ct
+
+#endif
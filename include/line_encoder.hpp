@@ -0,0 +1,46 @@
+#pragma once
+#ifndef BE_CTABLE_LINE_ENCODER_HPP_
+#define BE_CTABLE_LINE_ENCODER_HPP_
+
+#include "encoder_config.hpp"
+#include "line_program.hpp"
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Converts a LineProgram directly to bytes, without going through a
+///        std::ostream, using ANSI SGR sequences for colors.
+///
+/// \details Each line starts in the terminal's default colors and returns to
+///         them before it ends, so lines can be encoded independently.
+///         LogColor::initial is encoded as the default color.  Because the
+///         encoding depends only on the program, the exact number of bytes
+///         can be computed before anything is written.
+///
+///         Cursor forward sequences only produce the same result as blanks
+///         when the cells skipped over are already blank, as they are on a
+///         freshly scrolled or cleared terminal line.
+class LineEncoder final {
+public:
+   LineEncoder();
+   explicit LineEncoder(const EncoderConfig& config);
+
+   const EncoderConfig& config() const;
+
+   std::size_t line_size(const LineProgram& program, std::size_t line) const;
+   std::size_t size(const LineProgram& program) const;
+
+   char* encode_line(const LineProgram& program, std::size_t line, char* out) const;
+   char* encode(const LineProgram& program, char* out) const;
+   void encode(const LineProgram& program, S& out) const;
+
+private:
+   template <typename Output>
+   void encode_line_(const LineProgram& program, std::size_t line, Output& out) const;
+
+   EncoderConfig config_;
+};
+
+} // be::ct
+
+#endif
@@ -0,0 +1,95 @@
+#pragma once
+#ifndef BE_CTABLE_LINE_PROGRAM_HPP_
+#define BE_CTABLE_LINE_PROGRAM_HPP_
+
+#include <be/core/be.hpp>
+#include <be/core/console_color.hpp>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A flat list of output operations for each line of a frozen
+///        renderer tree, which can be executed without walking the tree.
+///
+/// \details LogColor::initial in a color op refers to the color that was
+///         in effect at the start of the line.
+class LineProgram final {
+public:
+   enum class op_type : U8 {
+      blank, // count spaces
+      glyph, // count copies of glyph
+      text,  // count chars from the text buffer, starting at offset
+      color
+   };
+
+   struct op {
+      op_type type;
+      char glyph;
+      LogColorState color;
+      U32 count;
+      U32 offset;
+   };
+
+   using const_iterator = std::vector<op>::const_iterator;
+
+   LineProgram();
+
+   std::size_t size() const;
+   bool empty() const;
+   I32 width() const;
+   void clear();
+
+   const_iterator begin(std::size_t line) const;
+   const_iterator end(std::size_t line) const;
+   std::string_view text(const op& o) const;
+
+   void render_line(std::ostream& os, std::size_t line) const;
+   void render(std::ostream& os) const;
+
+   void begin_line(I32 width);
+   void blank(U32 count);
+   void glyph(char glyph, U32 count = 1);
+   void text(std::string_view text);
+   void color(LogColorState color);
+
+private:
+   std::vector<op> ops_;
+   std::vector<std::size_t> lines_;
+   S text_;
+   I32 width_;
+};
+
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Stands in for std::ostream when a renderer tree is compiled to a
+///        LineProgram, tracking the color state that the stream would have.
+class LineProgramWriter final {
+public:
+   explicit LineProgramWriter(LineProgram& program);
+
+   void begin_line(I32 width);
+
+   LogColorState color() const;
+
+   LineProgramWriter& operator<<(const S& text);
+   LineProgramWriter& operator<<(char c);
+   LineProgramWriter& operator<<(LogColorState color);
+
+   // only found through ADL, so that it doesn't hide be::get_color
+   friend LogColorState get_color(const LineProgramWriter& writer) {
+      return writer.color();
+   }
+
+private:
+   LineProgram& program_;
+   LogColorState color_;
+};
+
+} // be::ct::detail
+} // be::ct
+
+#endif
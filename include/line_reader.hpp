@@ -0,0 +1,168 @@
+#pragma once
+#ifndef BE_CTABLE_LINE_READER_HPP_
+#define BE_CTABLE_LINE_READER_HPP_
+
+#include "table.hpp"
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define BE_CTABLE_COROUTINES
+#include <coroutine>
+#endif
+
+namespace be::ct {
+namespace detail {
+
+class TableRenderer;
+
+} // be::ct::detail
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Renders a table one line at a time, on demand, without a
+///        std::ostream.
+///
+/// \details Each line is encoded as by LineEncoder into a buffer which is
+///         reused for the next line, so a string_view returned by next() or
+///         an iterator is only valid until the reader advances.  Lines do
+///         not include a newline.  The table must outlive the reader.
+class LineReader final : Immovable {
+public:
+   class iterator final {
+   public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const std::string_view*;
+      using reference = const std::string_view&;
+
+      iterator() : reader_(nullptr) { }
+
+      reference operator*() const { return line_; }
+      pointer operator->() const { return &line_; }
+
+      iterator& operator++() {
+         if (!reader_->next(line_)) {
+            reader_ = nullptr;
+         }
+         return *this;
+      }
+
+      friend bool operator==(const iterator& a, const iterator& b) { return a.reader_ == b.reader_; }
+      friend bool operator!=(const iterator& a, const iterator& b) { return a.reader_ != b.reader_; }
+
+   private:
+      friend class LineReader;
+      explicit iterator(LineReader* reader) : reader_(reader) { ++*this; }
+
+      LineReader* reader_;
+      std::string_view line_;
+   };
+
+   LineReader(const Table& table, I32 max_total_width, const EncoderConfig& config = EncoderConfig());
+   LineReader(const Table& table, const LayoutSnapshot& layout, const EncoderConfig& config = EncoderConfig());
+   ~LineReader();
+
+   I32 width() const;
+
+   bool next(std::string_view& line);
+
+   iterator begin();
+   iterator end();
+
+private:
+   std::unique_ptr<detail::TableRenderer> renderer_;
+   LineEncoder encoder_;
+   LineProgram program_;
+   S buffer_;
+};
+
+#ifdef BE_CTABLE_COROUTINES
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The coroutine type returned by generate_lines().  Yields the same
+///        lines as LineReader, with the same lifetime restrictions.
+class LineGenerator final {
+public:
+   struct promise_type {
+      std::string_view line;
+
+      LineGenerator get_return_object() {
+         return LineGenerator(std::coroutine_handle<promise_type>::from_promise(*this));
+      }
+
+      std::suspend_always initial_suspend() noexcept { return { }; }
+      std::suspend_always final_suspend() noexcept { return { }; }
+
+      std::suspend_always yield_value(std::string_view value) noexcept {
+         line = value;
+         return { };
+      }
+
+      void return_void() noexcept { }
+      void unhandled_exception() { throw; }
+   };
+
+   using handle_type = std::coroutine_handle<promise_type>;
+
+   class iterator final {
+   public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const std::string_view*;
+      using reference = const std::string_view&;
+
+      iterator() = default;
+
+      reference operator*() const { return handle_.promise().line; }
+      pointer operator->() const { return &handle_.promise().line; }
+
+      iterator& operator++() {
+         handle_.resume();
+         return *this;
+      }
+
+      friend bool operator==(const iterator& it, std::default_sentinel_t) { return !it.handle_ || it.handle_.done(); }
+
+   private:
+      friend class LineGenerator;
+      explicit iterator(handle_type handle) : handle_(handle) { }
+
+      handle_type handle_;
+   };
+
+   LineGenerator(LineGenerator&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) { }
+   LineGenerator& operator=(LineGenerator&& other) noexcept {
+      std::swap(handle_, other.handle_);
+      return *this;
+   }
+
+   ~LineGenerator() {
+      if (handle_) {
+         handle_.destroy();
+      }
+   }
+
+   iterator begin() {
+      handle_.resume();
+      return iterator(handle_);
+   }
+
+   std::default_sentinel_t end() { return { }; }
+
+private:
+   explicit LineGenerator(handle_type handle) : handle_(handle) { }
+
+   handle_type handle_;
+};
+
+LineGenerator generate_lines(const Table& table, I32 max_total_width, EncoderConfig config = EncoderConfig());
+
+#endif
+
+} // be::ct
+
+#endif
@@ -0,0 +1,40 @@
+#pragma once
+#ifndef BE_CTABLE_LIVE_DISPLAY_HPP_
+#define BE_CTABLE_LIVE_DISPLAY_HPP_
+
+#include "line_encoder.hpp"
+#include <ostream>
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Redraws a table on a terminal in place, writing only the lines
+///        that changed since the previous frame.
+///
+/// \details Each update assumes the cursor is where the previous update left
+///         it: at the start of the line below the previous frame.  Lines
+///         are addressed relative to that position, so frames must fit on
+///         screen and lines must not be wider than the terminal.  Lines
+///         which no longer exist are erased.
+class LiveDisplay final {
+public:
+   LiveDisplay();
+   explicit LiveDisplay(const EncoderConfig& config);
+
+   const LineEncoder& encoder() const;
+
+   std::size_t lines() const;
+   void reset();
+
+   void update(const LineProgram& program, S& out);
+   void update(std::ostream& os, const LineProgram& program);
+
+private:
+   LineEncoder encoder_;
+   std::vector<S> lines_;
+   std::vector<std::size_t> hashes_;
+};
+
+} // be::ct
+
+#endif
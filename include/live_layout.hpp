@@ -0,0 +1,54 @@
+#pragma once
+#ifndef BE_CTABLE_LIVE_LAYOUT_HPP_
+#define BE_CTABLE_LIVE_LAYOUT_HPP_
+
+#include "layout_snapshot.hpp"
+
+namespace be::ct {
+namespace detail {
+
+class TableRenderer;
+
+} // be::ct::detail
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Carries column widths from one frame of a live-updating table to
+///        the next, so that columns don't jitter as values change.
+///
+/// \details The table is only re-laid out when the available width changes,
+///         the number of columns changes, a column's preferred width grows
+///         beyond the width it was laid out for, or at least one column
+///         could shrink by more than shrink_threshold for shrink_frames
+///         consecutive frames.
+class LiveLayout final {
+   friend class detail::TableRenderer;
+public:
+   LiveLayout();
+   LiveLayout(I32 shrink_threshold, U32 shrink_frames);
+
+   I32 shrink_threshold() const;
+   void shrink_threshold(I32 threshold);
+
+   U32 shrink_frames() const;
+   void shrink_frames(U32 frames);
+
+   const LayoutSnapshot& layout() const;
+   std::size_t layouts() const;
+   void reset();
+
+private:
+   bool needs_layout_(I32 max_total_width, const std::vector<I32>& pref_widths);
+   void record_(I32 max_total_width, std::vector<I32> pref_widths, const LayoutSnapshot& layout);
+
+   I32 shrink_threshold_;
+   U32 shrink_frames_;
+   U32 shrinkable_frames_;
+   I32 max_total_width_;
+   std::size_t layouts_;
+   std::vector<I32> pref_widths_;
+   LayoutSnapshot layout_;
+};
+
+} // be::ct
+
+#endif
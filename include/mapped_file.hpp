@@ -0,0 +1,20 @@
+#pragma once
+#ifndef BE_CTABLE_MAPPED_FILE_HPP_
+#define BE_CTABLE_MAPPED_FILE_HPP_
+
+#include "line_encoder.hpp"
+#include "table.hpp"
+
+namespace be::ct {
+
+/// \brief Writes an already compiled program; the whole table is in memory
+///        as the program's ops and text until the file is written.
+void write_mapped_file(const S& path, const LineProgram& program, const LineEncoder& encoder = LineEncoder());
+
+/// \brief Renders a table straight to the file, holding only one line in
+///        memory at a time.
+void write_mapped_file(const S& path, const Table& table, I32 max_total_width, const LineEncoder& encoder = LineEncoder());
+
+} // be::ct
+
+#endif
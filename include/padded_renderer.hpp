@@ -23,7 +23,9 @@ public:
         left_(left),
         fg_(LogColor::current),
         bg_(LogColor::current)
-   { }
+   {
+      inner_.parent(*this);
+   }
 
    PaddedRenderer(Inner& inner, pad_type top, pad_type right, pad_type bottom, pad_type left, LogColor fg, LogColor bg)
       : inner_(inner),
@@ -33,17 +35,19 @@ public:
         left_(left),
         fg_(fg),
         bg_(bg)
-   { }
+   {
+      inner_.parent(*this);
+   }
 
    pad_type top() const { return top_; }
    pad_type right() const { return right_; }
    pad_type bottom() const { return bottom_; }
    pad_type left() const { return left_; }
 
-   void top(pad_type value) { top_ = value; }
-   void right(pad_type value) { right_ = value; }
-   void bottom(pad_type value) { bottom_ = value; }
-   void left(pad_type value) { left_ = value; }
+   void top(pad_type value) { top_ = value; this->invalidate(); }
+   void right(pad_type value) { right_ = value; this->invalidate(); }
+   void bottom(pad_type value) { bottom_ = value; this->invalidate(); }
+   void left(pad_type value) { left_ = value; this->invalidate(); }
 
 private:
    I32 width_() const {
@@ -59,13 +63,20 @@ private:
       BaseRenderer<PaddedRenderer<Inner>>::freeze_();
    }
 
+   void thaw_() {
+      inner_.thaw();
+      BaseRenderer<PaddedRenderer<Inner>>::thaw_();
+   }
+
    using BaseRenderer<PaddedRenderer<Inner>>::render_blank_;
 
-   void render_blank_(std::ostream& os, I32 w) {
+   template <typename Stream>
+   void render_blank_(Stream& os, I32 w) {
       os << setcolor(fg_, bg_) << S((size_t)w, ' ');
    }
 
-   void render_(std::ostream& os) {
+   template <typename Stream>
+   void render_(Stream& os) {
       auto base_color = get_color(os);
 
       if (this->line_ < top_) {
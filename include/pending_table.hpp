@@ -0,0 +1,55 @@
+#pragma once
+#ifndef BE_CTABLE_PENDING_TABLE_HPP_
+#define BE_CTABLE_PENDING_TABLE_HPP_
+
+#include "table.hpp"
+#include <memory>
+
+namespace be::ct {
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Holds the most recently submitted table until it is taken,
+///        counting submissions that replaced one which was never taken.
+///
+/// \details Not synchronized; the owner guards it with the same mutex as
+///         the rest of its state, so that it can wait on a condition
+///         variable for a table to arrive.
+class PendingTable final {
+public:
+   PendingTable()
+      : coalesced_(0)
+   { }
+
+   explicit operator bool() const {
+      return table_ != nullptr;
+   }
+
+   /// \brief Stores table and returns the one it replaced, if any.  Callers
+   ///        should let the result go out of scope after releasing their
+   ///        lock, since destroying a large table can take a while.
+   std::unique_ptr<Table> replace(std::unique_ptr<Table> table) {
+      if (table_) {
+         ++coalesced_;
+      }
+      table_.swap(table);
+      return table;
+   }
+
+   std::unique_ptr<Table> take() {
+      return std::move(table_);
+   }
+
+   U64 coalesced() const {
+      return coalesced_;
+   }
+
+private:
+   std::unique_ptr<Table> table_;
+   U64 coalesced_;
+};
+
+} // be::ct::detail
+} // be::ct
+
+#endif
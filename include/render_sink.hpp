@@ -0,0 +1,33 @@
+#pragma once
+#ifndef BE_CTABLE_RENDER_SINK_HPP_
+#define BE_CTABLE_RENDER_SINK_HPP_
+
+#include "table.hpp"
+#include <vector>
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief One of the destinations written by render(const Table&, I32,
+///        const std::vector<RenderSink>&).
+///
+/// \details Stream sinks apply colors through the stream itself and precede
+///         each line with nl, exactly as operator<<(std::ostream&, const
+///         Table&) does, so they are suitable for consoles.  Other sinks
+///         write bytes produced by a LineEncoder using the given config,
+///         each line followed by '\n'.
+struct RenderSink {
+   std::ostream& os;
+   bool stream_colors;
+   EncoderConfig encoder;
+};
+
+RenderSink console_sink(std::ostream& os);
+RenderSink ansi_sink(std::ostream& os, const EncoderConfig& config = EncoderConfig());
+RenderSink plain_sink(std::ostream& os);
+
+void render(const Table& table, I32 max_total_width, const std::vector<RenderSink>& sinks);
+
+} // be::ct
+
+#endif
@@ -48,6 +48,8 @@ public:
    RowConfig& config();
    const RowConfig& config() const;
 
+   U64 hash() const;
+
 private:
    cell_container cells_;
    RowConfig config_;
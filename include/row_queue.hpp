@@ -0,0 +1,55 @@
+#pragma once
+#ifndef BE_CTABLE_ROW_QUEUE_HPP_
+#define BE_CTABLE_ROW_QUEUE_HPP_
+
+#include "row.hpp"
+#include <atomic>
+#include <memory>
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A bounded, lock-free queue of rows with any number of producers
+///        and a single consumer.
+///
+/// \details Each slot carries a sequence number which tells producers and
+///         the consumer whether it is free or filled for the current lap
+///         around the ring, so producers only contend on a single
+///         compare-and-swap and never wait for each other.  When the queue
+///         is full, push() either waits for the consumer to free a slot
+///         (overflow_policy::block) or discards the row and counts it
+///         (overflow_policy::drop).  The capacity is rounded up to a power
+///         of two.
+class RowQueue final : Immovable {
+public:
+   enum class overflow_policy : U8 {
+      block,
+      drop
+   };
+
+   explicit RowQueue(std::size_t capacity, overflow_policy policy = overflow_policy::block);
+
+   std::size_t capacity() const;
+   overflow_policy policy() const;
+   U64 dropped() const;
+
+   bool push(Row row);
+   bool try_pop(Row& row);
+
+private:
+   struct slot {
+      std::atomic<std::size_t> sequence;
+      Row row;
+   };
+
+   std::size_t mask_;
+   std::unique_ptr<slot[]> slots_;
+   overflow_policy policy_;
+   alignas(64) std::atomic<std::size_t> enqueue_pos_;
+   alignas(64) std::atomic<std::size_t> dequeue_pos_;
+   alignas(64) std::atomic<U64> dropped_;
+};
+
+} // be::ct
+
+#endif
@@ -39,18 +39,31 @@ public:
    void align(U8 align);
    U8 align() const;
 
+   void output_cache(CellOutputCache* cache);
+
 private:
    I32 width_() const;
    I32 height_() const;
 
    void freeze_();
-   void render_(std::ostream& os);
+   void thaw_();
+
+   template <typename Stream>
+   void render_(Stream& os) {
+      if (undecorated_) {
+         seq(os);
+      } else {
+         margin(os);
+      }
+   }
+
+   bool is_undecorated_() const;
 
-   void try_add_border_(BoxConfig::side side);
    void generate_border_(BoxConfig::side side);
    void resolve_border_colors_(BoxConfig::side side);
 
    const BoxConfig& config_;
+   bool undecorated_;
    U8 align_;
    std::vector<std::unique_ptr<CellRenderer>> cells_;
 };
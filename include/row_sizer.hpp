@@ -3,6 +3,7 @@
 #define BE_CTABLE_ROW_SIZER_HPP_
 
 #include "row_renderer.hpp"
+#include "layout_snapshot.hpp"
 
 namespace be::ct {
 namespace detail {
@@ -11,16 +12,17 @@ namespace detail {
 class RowSizer final {
 public:
    explicit RowSizer(RowRenderer& row);
+   RowSizer(RowRenderer& row, const RowLayout& layout);
 
    void set_heights();
 
+   RowLayout layout() const;
+
 private:
    RowRenderer* row_;
    U16 top_external_height_;
    U16 bottom_external_height_;
-   I32 pref_internal_height_;
-   I32 min_internal_height_;
-   I32 max_internal_height_;
+   I32 internal_height_;
 };
 
 } // be::ct::detail
@@ -0,0 +1,44 @@
+#pragma once
+#ifndef BE_CTABLE_STREAM_RENDERER_HPP_
+#define BE_CTABLE_STREAM_RENDERER_HPP_
+
+#include "row_queue.hpp"
+#include "table.hpp"
+#include <limits>
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Appends rows to a stream as they arrive, as if they were all part
+///        of one ever-growing table.
+///
+/// \details Rows are rendered in batches, each as a separate table using
+///         config, so any table-level borders and margins surround each
+///         batch; streamed tables usually put borders on rows instead.
+///         Column widths are sized from the stats of every row written so
+///         far, and carried between batches by a LiveLayout, so they never
+///         shrink and only change when a column needs to grow.
+class StreamRenderer final : Immovable {
+public:
+   StreamRenderer(std::ostream& os, TableConfig config, I32 max_total_width);
+
+   U64 rows() const;
+
+   void write(std::vector<Row> rows);
+   std::size_t drain(RowQueue& queue, std::size_t max_rows = std::numeric_limits<std::size_t>::max());
+
+private:
+   void write_(std::vector<Row>& rows);
+
+   std::ostream& os_;
+   TableConfig config_;
+   I32 max_total_width_;
+   std::vector<ColumnStats> stats_;
+   LiveLayout live_;
+   std::vector<Row> batch_;
+   U64 rows_;
+};
+
+} // be::ct
+
+#endif
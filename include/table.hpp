@@ -3,7 +3,15 @@
 #define BE_CTABLE_TABLE_HPP_
 
 #include "table_config.hpp"
+#include "column_stats.hpp"
+#include "layout_snapshot.hpp"
+#include "live_layout.hpp"
+#include "layout_cache.hpp"
+#include "cell_output_cache.hpp"
+#include "live_display.hpp"
+#include "line_program.hpp"
 #include "row.hpp"
+#include <memory>
 
 namespace be::ct {
 
@@ -45,11 +53,28 @@ public:
    TableConfig& config();
    const TableConfig& config() const;
 
+   U64 hash() const;
+
+   void seal();
+   bool sealed() const;
+
+   void track_column_stats(bool enabled);
+   bool tracking_column_stats() const;
+   const std::vector<ColumnStats>& column_stats() const;
+   void invalidate_column_stats();
+
 private:
    row_container rows_;
    TableConfig config_;
+   bool track_column_stats_;
+   bool sealed_;
+   mutable std::size_t column_stats_rows_;
+   mutable std::vector<ColumnStats> sealed_column_stats_;
+   mutable std::vector<ColumnStats> column_stats_;
 };
 
+std::shared_ptr<const Table> seal(Table table);
+
 using TableFunc = void (*)(Table& table);
 void row(Table& table);
 void header(Table& table);
@@ -87,6 +112,15 @@ Table operator<<(Table&& table, const T& other) {
 
 std::ostream& operator<<(std::ostream& os, const Table& table);
 
+LayoutSnapshot layout(const Table& table, I32 max_total_width = -1);
+void render(std::ostream& os, const Table& table, const LayoutSnapshot& layout);
+void render(std::ostream& os, const Table& table, LiveLayout& layout);
+void render(std::ostream& os, const Table& table, LiveLayout& layout, LiveDisplay& display);
+void render(std::ostream& os, const Table& table, LayoutCache& cache);
+void render(std::ostream& os, const Table& table, LayoutCache& layouts, CellOutputCache& cells);
+
+LineProgram compile(const Table& table, I32 max_total_width = -1);
+
 } // be::ct
 
 #endif
@@ -12,6 +12,8 @@ struct TableConfig {
    std::vector<RowConfig> rows;
    I16 header_repeat_modulo = 1;
    I16 row_repeat_modulo = 1;
+   F32 pref_width_percentile = 100; // columns prefer the width of this percentile of their cells; wider cells wrap
+   F32 line_count_budget_ms = 0; // when columns can't all have their preferred width, spend up to this long choosing widths that minimize wrapped lines
    BoxConfig box;
 };
 
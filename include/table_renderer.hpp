@@ -5,6 +5,10 @@
 #include "row_renderer.hpp"
 #include "vseq_renderer.hpp"
 #include "table.hpp"
+#include "layout_snapshot.hpp"
+#include "live_layout.hpp"
+#include "layout_cache.hpp"
+#include "line_program.hpp"
 
 namespace be::ct {
 namespace detail {
@@ -23,6 +27,7 @@ public:
    using margin_renderer_type = PaddedRenderer<border_renderer_type>;
 
    TableRenderer(const Table& table);
+   ~TableRenderer();
 
    seq_renderer_type seq;
    padding_renderer_type padding;
@@ -30,22 +35,51 @@ public:
    margin_renderer_type margin;
 
    void auto_size(I32 max_total_width = -1);
+   void auto_size(I32 max_total_width, LiveLayout& live);
+   void auto_size(I32 max_total_width, U64 table_hash, LayoutCache& cache);
+   void apply_layout(const LayoutSnapshot& layout);
    void combine_border_corners();
+   void output_cache(CellOutputCache* cache);
+   void column_stats(const std::vector<ColumnStats>& stats);
+
+   const LayoutSnapshot& layout() const;
+
+   LineProgram compile();
 
 private:
+   I32 fit_box_(I32 max_total_width);
+   void measure_();
+   void record_layout_();
+
    I32 width_() const;
    I32 height_() const;
 
    void freeze_();
-   void render_(std::ostream& os);
+   void thaw_();
+
+   template <typename Stream>
+   void render_(Stream& os) {
+      if (undecorated_) {
+         seq(os);
+      } else {
+         margin(os);
+      }
+   }
+
+   bool is_undecorated_() const;
 
-   void try_add_border_(BoxConfig::side side);
    void generate_border_(BoxConfig::side side);
    void resolve_border_colors_(BoxConfig::side side);
 
    const BoxConfig& config_;
+   bool undecorated_;
    U8 align_;
    std::vector<std::unique_ptr<RowRenderer>> rows_;
+   std::unique_ptr<TableSizer> sizer_;
+   const std::vector<ColumnStats>* column_stats_;
+   F32 pref_width_percentile_;
+   F32 line_count_budget_ms_;
+   LayoutSnapshot layout_;
 };
 
 } // be::ct::detail
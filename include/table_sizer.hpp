@@ -9,6 +9,9 @@ namespace be::ct {
 namespace detail {
 
 ///////////////////////////////////////////////////////////////////////////////
+/// \brief Measures rows as they are added, then sizes them to fit a given
+///        width.  Measurements are retained, so set_sizes() can be called
+///        again (e.g. after the renderers are thawed) without re-measuring.
 class TableSizer final {
    using row_vec_type = std::vector<RowRenderer*>;
    using column_vec_type = std::vector<ColumnSizer>;
@@ -16,16 +19,37 @@ public:
    TableSizer(std::size_t n_rows);
 
    void add(RowRenderer& row);
+   void column_stats(const std::vector<ColumnStats>& stats);
+   void pref_width_percentile(F32 percentile);
+   void line_count_budget(F32 budget_ms);
+   void skip_measurement();
 
    void set_sizes(I32 max_row_width);
+   void set_sizes(const LayoutSnapshot& layout);
+
+   void layout(LayoutSnapshot& layout) const;
+
+   std::vector<I32> pref_internal_widths() const;
 
 private:
+   void set_column_widths_(I32 max_internal_row_width);
+   void apply_(const std::vector<RowLayout>* row_layouts);
+   void minimize_line_count_(I32 remaining, std::vector<I32>& extras) const;
+
    row_vec_type rows_;
    column_vec_type columns_;
+   std::vector<RowLayout> row_layouts_;
    U16 left_margin_;
    U16 right_margin_;
    U16 left_padding_;
    U16 right_padding_;
+   U16 applied_left_margin_;
+   U16 applied_right_margin_;
+   U16 applied_left_padding_;
+   U16 applied_right_padding_;
+   F32 pref_width_percentile_;
+   F32 line_count_budget_ms_;
+   bool measure_cells_;
 };
 
 } // be::ct::detail
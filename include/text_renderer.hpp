@@ -4,6 +4,7 @@
 
 #include "base_renderer.hpp"
 #include "cell.hpp"
+#include "cell_output_cache.hpp"
 #include <be/core/console_color.hpp>
 #include <vector>
 
@@ -45,6 +46,8 @@ public:
    void align(U8 align);
    U8 align() const;
 
+   void output_cache(CellOutputCache* cache);
+
 private:
    I32 width_() const { return w_; }
    I32 height_() const { return h_; }
@@ -53,12 +56,25 @@ private:
    vec_type calc_data_(I32 width) const;
    void add_datum_(vec_type& data, I32 width, std::size_t& remaining, Cell::datum& d) const;
 
-   void render_(std::ostream& os);
-   void render_line_(std::ostream& os, I32 index);
+   const vec_type& lines_() const;
+
+   template <typename Stream>
+   void render_(Stream& os);
+
+   template <typename Stream>
+   void render_at_(Stream& os, I32 line);
+
+   template <typename Stream>
+   void render_line_(Stream& os, I32 index);
+
+   const CellOutputCache::program_ptr& program_();
 
    const Cell& cell_;
-   vec_type lines_;
-   I32 pref_w_;
+   mutable vec_type wrapped_lines_;
+   mutable bool wrapped_;
+   CellOutputCache* output_cache_;
+   CellOutputCache::program_ptr program_ptr_;
+   mutable I32 pref_w_;
    I32 w_;
    I32 h_;
    U8 align_;
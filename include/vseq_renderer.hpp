@@ -22,16 +22,26 @@ public:
    VSeqRenderer(vec_type inner)
       : inner_(std::move(inner)),
         index_(0)
-   { }
+   {
+      for (auto ptr : inner_) {
+         ptr->parent(*this);
+      }
+   }
 
    template <typename I>
    VSeqRenderer(I begin, I end)
       : inner_(begin, end),
         index_(0)
-   { }
+   {
+      for (auto ptr : inner_) {
+         ptr->parent(*this);
+      }
+   }
 
    void add(Inner* inner) {
       inner_.push_back(inner);
+      inner->parent(*this);
+      this->invalidate();
    }
 
 private:
@@ -56,7 +66,16 @@ private:
       BaseRenderer<VSeqRenderer<Inner>>::freeze_();
    }
 
-   void render_(std::ostream& os) {
+   void thaw_() {
+      index_ = 0;
+      for (auto ptr : inner_) {
+         ptr->thaw();
+      }
+      BaseRenderer<VSeqRenderer<Inner>>::thaw_();
+   }
+
+   template <typename Stream>
+   void render_(Stream& os) {
       for (;;) {
          if (index_ >= inner_.size()) {
             this->render_blank_(os);
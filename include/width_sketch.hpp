@@ -0,0 +1,38 @@
+#pragma once
+#ifndef BE_CTABLE_WIDTH_SKETCH_HPP_
+#define BE_CTABLE_WIDTH_SKETCH_HPP_
+
+#include <be/core/be.hpp>
+#include <vector>
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Compact, mergeable streaming quantile sketch for widths.
+///
+/// \details Widths below 32 are counted exactly; larger widths are counted in
+///         log-linear buckets (8 per power of two), so quantile() never
+///         underestimates and overestimates by at most 12.5%.  Storage grows
+///         only up to the bucket of the largest width seen.
+class WidthSketch final {
+public:
+   WidthSketch();
+
+   void add(I32 width);
+   void add(const WidthSketch& other);
+
+   bool empty() const;
+   U32 size() const;
+   I32 max() const;
+
+   I32 quantile(F32 q) const;
+
+private:
+   std::vector<U32> counts_;
+   U32 size_;
+   I32 max_;
+};
+
+} // be::ct
+
+#endif
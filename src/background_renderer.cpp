@@ -0,0 +1,122 @@
+#include "pch.hpp"
+#include "background_renderer.hpp"
+#include "table_renderer.hpp"
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+BackgroundRenderer::BackgroundRenderer(I32 max_total_width, const EncoderConfig& config)
+   : max_total_width_(max_total_width),
+     encoder_(config),
+     front_ready_(false),
+     busy_(false),
+     running_(true),
+     frames_(0),
+     thread_(&BackgroundRenderer::run_, this)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Finishes rendering any pending table, then stops the worker.
+BackgroundRenderer::~BackgroundRenderer() {
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_ = false;
+   }
+   cv_.notify_all();
+   thread_.join();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Queues a snapshot of a table for rendering, replacing any table
+///        that the worker hasn't started on yet.  Safe to call from any
+///        thread; never waits for rendering.
+void BackgroundRenderer::submit(Table table) {
+   auto ptr = std::make_unique<Table>(std::move(table));
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ptr = pending_.replace(std::move(ptr));
+   }
+   cv_.notify_all();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Blocks until every submitted table has been rendered.
+void BackgroundRenderer::wait() {
+   std::unique_lock<std::mutex> lock(mutex_);
+   cv_.wait(lock, [this]() { return !pending_ && !busy_; });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Swaps the most recently rendered frame into frame, if it hasn't
+///        been taken already.  The previous contents of frame are reused as
+///        a buffer for a later frame.
+bool BackgroundRenderer::take(S& frame) {
+   std::lock_guard<std::mutex> lock(mutex_);
+   if (!front_ready_) {
+      return false;
+   }
+   frame.swap(front_);
+   front_ready_ = false;
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Writes the most recently rendered frame to os, if it hasn't been
+///        taken already.
+bool BackgroundRenderer::write(std::ostream& os) {
+   if (!take(out_)) {
+      return false;
+   }
+   os.write(out_.data(), out_.size());
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+U64 BackgroundRenderer::frames() const {
+   std::lock_guard<std::mutex> lock(mutex_);
+   return frames_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The number of submitted snapshots which were replaced before they
+///        could be rendered.
+U64 BackgroundRenderer::coalesced() const {
+   std::lock_guard<std::mutex> lock(mutex_);
+   return pending_.coalesced();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void BackgroundRenderer::run_() {
+   std::unique_lock<std::mutex> lock(mutex_);
+   for (;;) {
+      cv_.wait(lock, [this]() { return pending_ || !running_; });
+      if (!pending_) {
+         return;
+      }
+
+      std::unique_ptr<Table> table = pending_.take();
+      busy_ = true;
+      lock.unlock();
+
+      LineProgram program;
+      {
+         detail::TableRenderer r(*table);
+         r.auto_size(max_total_width_, table->hash(), layouts_);
+         r.combine_border_corners();
+         program = r.compile();
+      }
+      table.reset();
+
+      back_.clear();
+      encoder_.encode(program, back_);
+
+      lock.lock();
+      front_.swap(back_);
+      front_ready_ = true;
+      busy_ = false;
+      ++frames_;
+      cv_.notify_all();
+   }
+}
+
+} // be::ct
@@ -1,34 +1,17 @@
 #include "pch.hpp"
-#include "border_config.hpp"
+#include "compiled_border_pattern.hpp"
 #include <gsl/string_span>
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <shared_mutex>
+#include <string_view>
 
 namespace be::ct {
 namespace {
 
-///////////////////////////////////////////////////////////////////////////////
-bool is_hex_digit(char c) {
-   return c >= '0' && c <= '9' ||
-      c >= 'a' && c <= 'f' ||
-      c >= 'A' && c <= 'F';
-}
-
-///////////////////////////////////////////////////////////////////////////////
-U8 hex_digit(char c) {
-   if (c >= '0' && c <= '9') {
-      return c - '0';
-   }
-
-   if (c >= 'a' && c <= 'f') {
-      return c - 'a' + 0xA;
-   }
-
-   if (c >= 'A' && c <= 'F') {
-      return c - 'A' + 0xA;
-   }
-
-   return 0;
-}
+using detail::is_hex_digit;
+using detail::hex_digit;
 
 ///////////////////////////////////////////////////////////////////////////////
 void expand(std::vector<BorderChar>& results, const char* group, std::size_t group_length, std::size_t width) {
@@ -99,6 +82,43 @@ void expand(std::vector<BorderChar>& results, const char* group, std::size_t gro
    }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+struct PatternKey {
+   S pattern;
+   std::size_t width;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+struct PatternKeyLess {
+   using is_transparent = void;
+   using view = std::pair<std::string_view, std::size_t>;
+
+   static view as_view(const PatternKey& key) { return view(key.pattern, key.width); }
+   static const view& as_view(const view& key) { return key; }
+
+   template <typename A, typename B>
+   bool operator()(const A& a, const B& b) const {
+      return as_view(a) < as_view(b);
+   }
+};
+
+// Patterns are almost always string literals from a handful of BoxConfigs,
+// so this only overflows if widths are wildly varied; in that case it's
+// simply cleared and refilled.
+const std::size_t max_cached_patterns = 4096;
+
+///////////////////////////////////////////////////////////////////////////////
+std::shared_mutex& pattern_cache_mutex() {
+   static std::shared_mutex mutex;
+   return mutex;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::map<PatternKey, std::vector<BorderChar>, PatternKeyLess>& pattern_cache() {
+   static std::map<PatternKey, std::vector<BorderChar>, PatternKeyLess> cache;
+   return cache;
+}
+
 } // be::ct::()
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -229,4 +249,35 @@ std::vector<BorderChar> expand_border_pattern(const char* pattern, std::size_t w
    return results;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Equivalent to out = expand_border_pattern(pattern, width), but
+///        each (pattern, width) pair is only parsed and expanded once per
+///        process.  Safe to call from multiple threads.
+void expand_border_pattern(const char* pattern, std::size_t width, std::vector<BorderChar>& out) {
+   if (!pattern) {
+      out.assign(width, BorderChar());
+      return;
+   }
+
+   PatternKeyLess::view key(pattern, width);
+   auto& cache = pattern_cache();
+
+   {
+      std::shared_lock<std::shared_mutex> lock(pattern_cache_mutex());
+      auto it = cache.find(key);
+      if (it != cache.end()) {
+         out = it->second;
+         return;
+      }
+   }
+
+   out = expand_border_pattern(pattern, width);
+
+   std::unique_lock<std::shared_mutex> lock(pattern_cache_mutex());
+   if (cache.size() >= max_cached_patterns) {
+      cache.clear();
+   }
+   cache.emplace(PatternKey { S(key.first), width }, out);
+}
+
 } // be::ct
@@ -1,6 +1,7 @@
 #include "pch.hpp"
 #include "cell.hpp"
 #include "cell_renderer.hpp"
+#include "content_hash.hpp"
 
 namespace be::ct {
 
@@ -8,7 +9,8 @@ namespace be::ct {
 Cell::Cell()
    : fg_(LogColor::current),
      bg_(LogColor::current),
-     stream_status_(stream_status::uninitialized)
+     stream_status_(stream_status::uninitialized),
+     hash_(detail::content_hash_basis)
 { }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -16,6 +18,7 @@ Cell::Cell(CellConfig config)
    : fg_(LogColor::current),
      bg_(LogColor::current),
      stream_status_(stream_status::uninitialized),
+     hash_(detail::content_hash_basis),
      config_(std::move(config))
 { }
 
@@ -24,10 +27,12 @@ Cell::Cell(const Cell& other)
    : fg_(other.fg_),
      bg_(other.bg_),
      stream_status_(stream_status::clean),
+     hash_(detail::content_hash_basis),
      config_(other.config_)
 {
    other.clean();
    data_.assign(other.data_.begin(), other.data_.end());
+   hash_ = other.hash_;
    set_ostream_config(stream_, get_ostream_config(other.stream_));
 }
 
@@ -39,6 +44,7 @@ Cell& Cell::operator=(Cell other) {
    swap(stream_status_, other.stream_status_);
    swap(stream_, other.stream_);
    swap(data_, other.data_);
+   swap(hash_, other.hash_);
    swap(config_, other.config_);
    return *this;
 }
@@ -103,13 +109,13 @@ void Cell::clean() const {
             }
 
             if (found_break) {
-               data_.push_back({ S(start, it), fg_, bg_, true });
+               add_datum_({ S(start, it), fg_, bg_, true });
                start = it + 1;
             }
          }
 
          if (start != str.end()) {
-            data_.push_back({ S(start, str.end()), fg_, bg_, false });
+            add_datum_({ S(start, str.end()), fg_, bg_, false });
          }
       }
       stream_.str(S());
@@ -118,6 +124,21 @@ void Cell::clean() const {
    }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Returns a hash of the cell's content and the parts of its config
+///        which affect its size.  The content hash is maintained as data is
+///        added, so this doesn't need to look at the cell's text.
+U64 Cell::hash() const {
+   clean();
+   U64 hash = hash_;
+   hash = detail::hash_value(hash, config_.min_width);
+   hash = detail::hash_value(hash, config_.pref_width);
+   hash = detail::hash_value(hash, config_.max_width);
+   hash = detail::hash_value(hash, config_.min_height);
+   hash = detail::hash_value(hash, config_.max_height);
+   return detail::hash_box_config(hash, config_.box);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void Cell::init_stream_() const {
    if (stream_status_ == stream_status::uninitialized) {
@@ -126,6 +147,16 @@ void Cell::init_stream_() const {
    }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void Cell::add_datum_(datum d) const {
+   hash_ = detail::hash_bytes(hash_, d.text.data(), d.text.size());
+   hash_ = detail::hash_value(hash_, d.text.size());
+   hash_ = detail::hash_value(hash_, d.foreground);
+   hash_ = detail::hash_value(hash_, d.background);
+   hash_ = detail::hash_value(hash_, d.linebreak);
+   data_.push_back(std::move(d));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void clean(Cell& cell) {
    cell.clean();
@@ -149,7 +180,7 @@ Cell& operator<<(Cell& cell, const Cell& other) {
    cell.clean();
    cell.data_.reserve(cell.data_.size() + other.data_.size());
    for (const Cell::datum& d : other.data_) {
-      cell.data_.push_back(d);
+      cell.add_datum_(d);
    }
    set_ostream_config(cell.stream_, get_ostream_config(other.stream_));
 
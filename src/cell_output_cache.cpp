@@ -0,0 +1,91 @@
+#include "pch.hpp"
+#include "cell_output_cache.hpp"
+#include "content_hash.hpp"
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+CellOutputCache::CellOutputCache()
+   : capacity_(4096),
+     hits_(0),
+     misses_(0)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+CellOutputCache::CellOutputCache(std::size_t capacity)
+   : capacity_(capacity),
+     hits_(0),
+     misses_(0)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t CellOutputCache::capacity() const {
+   return capacity_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t CellOutputCache::size() const {
+   return entries_.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CellOutputCache::clear() {
+   index_.clear();
+   entries_.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+U64 CellOutputCache::hits() const {
+   return hits_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+U64 CellOutputCache::misses() const {
+   return misses_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+CellOutputCache::program_ptr CellOutputCache::find(const key& k) {
+   auto it = index_.find(k);
+   if (it == index_.end()) {
+      ++misses_;
+      return program_ptr();
+   }
+
+   ++hits_;
+   entries_.splice(entries_.begin(), entries_, it->second);
+   return it->second->second;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CellOutputCache::insert(const key& k, program_ptr program) {
+   if (capacity_ == 0) {
+      return;
+   }
+
+   auto it = index_.find(k);
+   if (it != index_.end()) {
+      it->second->second = std::move(program);
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+   }
+
+   if (entries_.size() >= capacity_) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+   }
+
+   entries_.emplace_front(k, std::move(program));
+   index_.emplace(k, entries_.begin());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t CellOutputCache::key_hash::operator()(const key& k) const {
+   U64 hash = detail::hash_value(detail::content_hash_basis, k.cell_hash);
+   hash = detail::hash_value(hash, k.width);
+   hash = detail::hash_value(hash, k.height);
+   hash = detail::hash_value(hash, k.align);
+   return (std::size_t)hash;
+}
+
+} // be::ct
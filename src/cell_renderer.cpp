@@ -1,18 +1,14 @@
 #include "pch.hpp"
 #include "cell_renderer.hpp"
+#include "box_state.hpp"
 
 namespace be::ct {
 namespace detail {
 namespace {
 
-///////////////////////////////////////////////////////////////////////////////
-U8 get_margin(const BorderConfig& config) {
-   return config.margin > 0 ? config.margin - 1 : 0;
-}
-
 ///////////////////////////////////////////////////////////////////////////////
 U8 get_margin(const Cell& cell, BoxConfig::side side) {
-   return get_margin(cell.config().box.sides[side]);
+   return border_margin(cell.config().box.sides[side]);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -38,15 +34,15 @@ CellRenderer::CellRenderer(const Cell& cell)
             get_margin(cell, BoxConfig::right_side),
             get_margin(cell, BoxConfig::bottom_side),
             get_margin(cell, BoxConfig::left_side)),
-     config_(cell.config().box)
+     config_(cell.config().box),
+     undecorated_(false)
 {
+   margin.parent(*this);
+
    border.foreground(cell.config().box.foreground);
    border.background(cell.config().box.background);
 
-   try_add_border_(BoxConfig::top_side);
-   try_add_border_(BoxConfig::right_side);
-   try_add_border_(BoxConfig::bottom_side);
-   try_add_border_(BoxConfig::left_side);
+   add_box_borders(border, config_);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -96,6 +92,8 @@ void CellRenderer::combine_border_corners() {
             bc = config_.corners(bc, border.right().back(), BoxConfig::bottom_side, BoxConfig::right_side);
          }
       }
+
+      border.prepare();
    }
 }
 
@@ -109,6 +107,16 @@ I32 CellRenderer::height_() const {
    return margin.height();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief True if there are no margins, borders, padding, or box colors, in
+///        which case rendering can skip straight to the text.
+bool CellRenderer::is_undecorated_() const {
+   return config_.foreground == LogColor::current &&
+      config_.background == LogColor::current &&
+      margin.width() == text.width() &&
+      margin.height() == text.height();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void CellRenderer::freeze_() {
    bool generate_borders = cached_width_ == -1;
@@ -119,20 +127,19 @@ void CellRenderer::freeze_() {
       generate_border_(BoxConfig::right_side);
       generate_border_(BoxConfig::bottom_side);
       generate_border_(BoxConfig::left_side);
+      border.prepare();
    }
+   undecorated_ = is_undecorated_();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void CellRenderer::render_(std::ostream& os) {
-   margin(os);
-}
-
-///////////////////////////////////////////////////////////////////////////////
-void CellRenderer::try_add_border_(BoxConfig::side side) {
-   if (config_.sides[side].margin > 0) {
-      border.enabled(side, true);
-      border.top().emplace_back();
-   }
+/// \brief Restores the margins, padding, and borders that sizing may have
+///        trimmed, so that a new size can be applied.
+void CellRenderer::thaw_() {
+   margin.thaw();
+   base::thaw_();
+   undecorated_ = false;
+   restore_box(*this, config_);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -143,7 +150,7 @@ void CellRenderer::generate_border_(BoxConfig::side side) {
       std::size_t size = 2 + (side == BoxConfig::top_side || side == BoxConfig::bottom_side ?
                               padding.width() : padding.height());
 
-      b = expand_border_pattern(pattern, size);
+      expand_border_pattern(pattern, size, b);
       resolve_border_colors_(side);
    }
 }
@@ -0,0 +1,70 @@
+#include "pch.hpp"
+#include "column_stats.hpp"
+#include "text_renderer.hpp"
+#include "row.hpp"
+#include <be/core/alg.hpp>
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+void ColumnStats::add(const ColumnStats& other) {
+   left_external = max(left_external, other.left_external);
+   right_external = max(right_external, other.right_external);
+   pref_internal = max(pref_internal, other.pref_internal);
+   min_internal = max(min_internal, other.min_internal);
+   max_internal = min(max_internal, other.max_internal);
+   max_internal = max(max_internal, min_internal);
+   pref_sketch.add(other.pref_sketch);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Returns the preferred internal width to use when the column should
+///        fit the given percentile of its cells, rather than all of them.
+I32 ColumnStats::pref_internal_percentile(F32 percentile) const {
+   if (percentile >= 100 || pref_sketch.empty()) {
+      return pref_internal;
+   }
+   return max(pref_sketch.quantile(percentile / 100), min_internal);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Measures a cell the same way ColumnSizer measures a freshly
+///        constructed CellRenderer, without building one.
+ColumnStats measure_cell(const Cell& cell) {
+   const BoxConfig& box = cell.config().box;
+   const BorderConfig& left = box.sides[BoxConfig::left_side];
+   const BorderConfig& right = box.sides[BoxConfig::right_side];
+
+   detail::TextRenderer text(cell);
+   I32 padding = left.padding + right.padding;
+
+   ColumnStats stats;
+   stats.left_external = left.margin;
+   stats.right_external = right.margin;
+   stats.pref_internal = padding + text.pref_width();
+   stats.min_internal = padding + text.min_width();
+   stats.max_internal = max(padding + text.max_width(), stats.min_internal);
+   return stats;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Measures each cell of a row and folds it into the stats for its
+///        column.  If sketch is true, each cell's preferred width is also
+///        added to the column's pref_sketch.
+void add_column_stats(std::vector<ColumnStats>& stats, const Row& row, bool sketch) {
+   if (stats.size() < row.size()) {
+      stats.resize(row.size());
+   }
+
+   std::size_t column = 0;
+   for (const Cell& cell : row) {
+      ColumnStats cell_stats = measure_cell(cell);
+      stats[column].add(cell_stats);
+      if (sketch) {
+         stats[column].pref_sketch.add(cell_stats.pref_internal);
+      }
+      ++column;
+   }
+}
+
+} // be::ct
@@ -0,0 +1,118 @@
+#include "pch.hpp"
+#include "frame_scheduler.hpp"
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+FrameScheduler::FrameScheduler(std::ostream& os, F64 max_fps)
+   : os_(os),
+     min_interval_(std::chrono::duration_cast<clock::duration>(std::chrono::duration<F64>(max_fps > 0 ? 1 / max_fps : 0))),
+     next_frame_(clock::now()),
+     frames_(0),
+     running_(false)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+FrameScheduler::~FrameScheduler() {
+   stop();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Replaces the pending frame.  Safe to call from any thread.
+void FrameScheduler::submit(Table table) {
+   auto ptr = std::make_unique<Table>(std::move(table));
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ptr = pending_.replace(std::move(ptr));
+   }
+   cv_.notify_one();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Draws the pending frame, if there is one and enough time has
+///        passed since the previous frame.  Returns true if a frame was
+///        drawn.
+bool FrameScheduler::tick() {
+   std::lock_guard<std::mutex> draw_lock(draw_mutex_);
+
+   std::unique_ptr<Table> table;
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      clock::time_point now = clock::now();
+      if (!pending_ || now < next_frame_) {
+         return false;
+      }
+      table = pending_.take();
+      next_frame_ = now + min_interval_;
+   }
+
+   render(os_, *table, layout_, display_);
+   os_.flush();
+
+   std::lock_guard<std::mutex> lock(mutex_);
+   ++frames_;
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Starts drawing frames from a separate thread.
+void FrameScheduler::start() {
+   std::lock_guard<std::mutex> lock(mutex_);
+   if (!running_) {
+      running_ = true;
+      thread_ = std::thread(&FrameScheduler::run_, this);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Stops the thread started by start(), if any, then draws the pending
+///        frame, if any, so that the final state is always shown.
+void FrameScheduler::stop() {
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_ = false;
+   }
+   cv_.notify_one();
+
+   if (thread_.joinable()) {
+      thread_.join();
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      next_frame_ = clock::now();
+   }
+   tick();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+U64 FrameScheduler::frames() const {
+   std::lock_guard<std::mutex> lock(mutex_);
+   return frames_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The number of submitted snapshots which were replaced before they
+///        could be drawn.
+U64 FrameScheduler::coalesced() const {
+   std::lock_guard<std::mutex> lock(mutex_);
+   return pending_.coalesced();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FrameScheduler::run_() {
+   std::unique_lock<std::mutex> lock(mutex_);
+   while (running_) {
+      if (!pending_) {
+         cv_.wait(lock);
+      } else if (clock::now() < next_frame_) {
+         cv_.wait_until(lock, next_frame_);
+      } else {
+         lock.unlock();
+         tick();
+         lock.lock();
+      }
+   }
+}
+
+} // be::ct
@@ -0,0 +1,67 @@
+#include "pch.hpp"
+#include "layout_cache.hpp"
+#include <algorithm>
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+LayoutCache::LayoutCache()
+   : capacity_(16)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+LayoutCache::LayoutCache(std::size_t capacity)
+   : capacity_(capacity)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t LayoutCache::capacity() const {
+   return capacity_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t LayoutCache::size() const {
+   return entries_.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LayoutCache::clear() {
+   entries_.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Returns the cached layout, or nullptr if there isn't one.  The
+///        result is invalidated by the next call to find() or insert().
+const LayoutSnapshot* LayoutCache::find(U64 table_hash, I32 max_total_width) {
+   auto it = std::find_if(entries_.begin(), entries_.end(), [=](const entry& e) {
+         return e.table_hash == table_hash && e.max_total_width == max_total_width;
+      });
+
+   if (it == entries_.end()) {
+      return nullptr;
+   }
+
+   std::rotate(entries_.begin(), it, it + 1);
+   return &entries_.front().layout;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LayoutCache::insert(U64 table_hash, I32 max_total_width, const LayoutSnapshot& layout) {
+   if (capacity_ == 0) {
+      return;
+   }
+
+   auto it = std::find_if(entries_.begin(), entries_.end(), [=](const entry& e) {
+         return e.table_hash == table_hash && e.max_total_width == max_total_width;
+      });
+
+   if (it != entries_.end()) {
+      entries_.erase(it);
+   } else if (entries_.size() >= capacity_) {
+      entries_.pop_back();
+   }
+
+   entries_.insert(entries_.begin(), entry { table_hash, max_total_width, layout });
+}
+
+} // be::ct
@@ -0,0 +1,312 @@
+#include "pch.hpp"
+#include "line_encoder.hpp"
+#include <cstring>
+
+namespace be::ct {
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+struct SizeOutput {
+   std::size_t size = 0;
+
+   void put(const char*, std::size_t n) { size += n; }
+   void fill(char, std::size_t n) { size += n; }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+struct BufferOutput {
+   char* ptr;
+
+   void put(const char* data, std::size_t n) {
+      std::memcpy(ptr, data, n);
+      ptr += n;
+   }
+
+   void fill(char c, std::size_t n) {
+      std::memset(ptr, c, n);
+      ptr += n;
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Resolves LogColor::current against the previous state, and
+///        LogColor::other to the color of the opposite plane.
+LogColorState resolve_color(LogColorState color, LogColorState prev) {
+   if (color.fg == LogColor::current) {
+      color.fg = prev.fg;
+   }
+   if (color.bg == LogColor::current) {
+      color.bg = prev.bg;
+   }
+   if (color.fg == LogColor::other) {
+      color.fg = color.bg == LogColor::other ? LogColor::initial : color.bg;
+   }
+   if (color.bg == LogColor::other) {
+      color.bg = color.fg;
+   }
+   return color;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+U8 sgr_code(LogColor color, U8 base) {
+   U8 c = static_cast<U8>(color);
+   if (c < 8) {
+      return base + c;
+   } else if (c < 16) {
+      return base + 60 + c - 8;
+   }
+   return base + 9; // default color
+}
+
+///////////////////////////////////////////////////////////////////////////////
+char* write_code(char* ptr, U8 code) {
+   if (code >= 100) {
+      *ptr++ = '0' + code / 100;
+   }
+   *ptr++ = '0' + code / 10 % 10;
+   *ptr++ = '0' + code % 10;
+   return ptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Output>
+void write_sgr(Output& out, LogColorState from, LogColorState to) {
+   if (from.fg == to.fg && from.bg == to.bg) {
+      return;
+   }
+
+   char buf[16];
+   char* ptr = buf;
+   *ptr++ = '\x1b';
+   *ptr++ = '[';
+   if (from.fg != to.fg) {
+      ptr = write_code(ptr, sgr_code(to.fg, 30));
+   }
+   if (from.bg != to.bg) {
+      if (from.fg != to.fg) {
+         *ptr++ = ';';
+      }
+      ptr = write_code(ptr, sgr_code(to.bg, 40));
+   }
+   *ptr++ = 'm';
+   out.put(buf, ptr - buf);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Writes CSI n C, moving the cursor forward n columns, if that is
+///        shorter than writing n spaces.
+template <typename Output>
+bool write_cursor_forward(Output& out, std::size_t n) {
+   char buf[32];
+   char* end = buf + sizeof(buf);
+   char* ptr = end;
+   *--ptr = 'C';
+   std::size_t v = n;
+   do {
+      *--ptr = '0' + v % 10;
+      v /= 10;
+   } while (v > 0);
+   *--ptr = '[';
+   *--ptr = '\x1b';
+
+   std::size_t length = end - ptr;
+   if (length >= n) {
+      return false;
+   }
+
+   out.put(ptr, length);
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Writes a single line, deferring color changes until something is
+///        written in the new color, and optionally deferring blanks that
+///        have the default background so that trailing ones can be dropped
+///        or long runs replaced with cursor movement.
+template <typename Output>
+class LineWriter final {
+public:
+   LineWriter(const EncoderConfig& config, Output& out)
+      : out_(out),
+        color_enabled_(config.color),
+        trim_(config.trim_trailing_blanks),
+        cursor_forward_threshold_(config.cursor_forward_threshold),
+        emitted_ { LogColor::initial, LogColor::initial },
+        target_ { LogColor::initial, LogColor::initial },
+        pending_(0)
+   { }
+
+   void blank(std::size_t n) {
+      if ((trim_ || cursor_forward_threshold_ > 0) &&
+          (!color_enabled_ || target_.bg == LogColor::initial)) {
+         pending_ += n;
+      } else {
+         fill(' ', n);
+      }
+   }
+
+   void fill(char c, std::size_t n) {
+      prepare_();
+      out_.fill(c, n);
+   }
+
+   void text(std::string_view text) {
+      std::size_t visible = text.find_last_not_of(' ') + 1;
+      if (trim_ && visible < text.size()) {
+         put_(text.data(), visible);
+         blank(text.size() - visible);
+      } else {
+         put_(text.data(), text.size());
+      }
+   }
+
+   void color(LogColorState color) {
+      if (color_enabled_) {
+         target_ = resolve_color(color, target_);
+      }
+   }
+
+   void finish() {
+      if (!trim_) {
+         flush_();
+      }
+
+      if (color_enabled_) {
+         write_sgr(out_, emitted_, LogColorState { LogColor::initial, LogColor::initial });
+      }
+   }
+
+private:
+   void put_(const char* data, std::size_t n) {
+      if (n > 0) {
+         prepare_();
+         out_.put(data, n);
+      }
+   }
+
+   void prepare_() {
+      flush_();
+      if (color_enabled_) {
+         write_sgr(out_, emitted_, target_);
+         emitted_ = target_;
+      }
+   }
+
+   void flush_() {
+      if (pending_ > 0) {
+         if (cursor_forward_threshold_ > 0 && pending_ >= cursor_forward_threshold_ &&
+             write_cursor_forward(out_, pending_)) {
+            pending_ = 0;
+            return;
+         }
+
+         if (color_enabled_ && emitted_.bg != LogColor::initial) {
+            LogColorState color { emitted_.fg, LogColor::initial };
+            write_sgr(out_, emitted_, color);
+            emitted_ = color;
+         }
+         out_.fill(' ', pending_);
+         pending_ = 0;
+      }
+   }
+
+   Output& out_;
+   bool color_enabled_;
+   bool trim_;
+   U32 cursor_forward_threshold_;
+   LogColorState emitted_;
+   LogColorState target_;
+   std::size_t pending_;
+};
+
+} // be::ct::()
+
+///////////////////////////////////////////////////////////////////////////////
+LineEncoder::LineEncoder() { }
+
+///////////////////////////////////////////////////////////////////////////////
+LineEncoder::LineEncoder(const EncoderConfig& config)
+   : config_(config)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+const EncoderConfig& LineEncoder::config() const {
+   return config_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Returns the exact number of bytes encode_line() will write,
+///        not including a newline.
+std::size_t LineEncoder::line_size(const LineProgram& program, std::size_t line) const {
+   SizeOutput out;
+   encode_line_(program, line, out);
+   return out.size;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Returns the exact number of bytes encode() will write, including
+///        the newline after each line.
+std::size_t LineEncoder::size(const LineProgram& program) const {
+   SizeOutput out;
+   for (std::size_t line = 0, n = program.size(); line < n; ++line) {
+      encode_line_(program, line, out);
+   }
+   return out.size + program.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Writes line_size(program, line) bytes to out and returns the end
+///        of the written range.
+char* LineEncoder::encode_line(const LineProgram& program, std::size_t line, char* out) const {
+   BufferOutput buf { out };
+   encode_line_(program, line, buf);
+   return buf.ptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Writes size(program) bytes to out, terminating each line with a
+///        newline, and returns the end of the written range.
+char* LineEncoder::encode(const LineProgram& program, char* out) const {
+   BufferOutput buf { out };
+   for (std::size_t line = 0, n = program.size(); line < n; ++line) {
+      encode_line_(program, line, buf);
+      buf.fill('\n', 1);
+   }
+   return buf.ptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Appends the encoded program to out.
+void LineEncoder::encode(const LineProgram& program, S& out) const {
+   std::size_t offset = out.size();
+   out.resize(offset + size(program));
+   encode(program, &out[0] + offset);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Output>
+void LineEncoder::encode_line_(const LineProgram& program, std::size_t line, Output& out) const {
+   LineWriter<Output> writer(config_, out);
+
+   for (auto it = program.begin(line), end = program.end(line); it != end; ++it) {
+      const LineProgram::op& o = *it;
+      switch (o.type) {
+         case LineProgram::op_type::blank:
+            writer.blank(o.count);
+            break;
+         case LineProgram::op_type::glyph:
+            writer.fill(o.glyph, o.count);
+            break;
+         case LineProgram::op_type::text:
+            writer.text(program.text(o));
+            break;
+         case LineProgram::op_type::color:
+            writer.color(o.color);
+            break;
+      }
+   }
+
+   writer.finish();
+}
+
+} // be::ct
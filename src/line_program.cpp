@@ -0,0 +1,223 @@
+#include "pch.hpp"
+#include "line_program.hpp"
+#include <be/core/console.hpp>
+#include <algorithm>
+
+namespace be::ct {
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+void write_repeated(std::ostream& os, char c, U32 count) {
+   char buf[64];
+   std::fill(std::begin(buf), std::end(buf), c);
+   while (count > 0) {
+      U32 n = std::min(count, (U32)sizeof(buf));
+      os.write(buf, n);
+      count -= n;
+   }
+}
+
+} // be::ct::()
+
+///////////////////////////////////////////////////////////////////////////////
+LineProgram::LineProgram()
+   : width_(0)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t LineProgram::size() const {
+   return lines_.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool LineProgram::empty() const {
+   return lines_.empty();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+I32 LineProgram::width() const {
+   return width_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Removes all lines, but keeps allocated memory so that the program
+///        can be reused.
+void LineProgram::clear() {
+   ops_.clear();
+   lines_.clear();
+   text_.clear();
+   width_ = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+LineProgram::const_iterator LineProgram::begin(std::size_t line) const {
+   return ops_.begin() + lines_[line];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+LineProgram::const_iterator LineProgram::end(std::size_t line) const {
+   return line + 1 < lines_.size() ? ops_.begin() + lines_[line + 1] : ops_.end();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::string_view LineProgram::text(const op& o) const {
+   return std::string_view(text_.data() + o.offset, o.count);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LineProgram::render_line(std::ostream& os, std::size_t line) const {
+   LogColorState base = get_color(os);
+   for (auto it = begin(line), e = end(line); it != e; ++it) {
+      const op& o = *it;
+      switch (o.type) {
+         case op_type::blank:
+            write_repeated(os, ' ', o.count);
+            break;
+         case op_type::glyph:
+            write_repeated(os, o.glyph, o.count);
+            break;
+         case op_type::text:
+            os.write(text_.data() + o.offset, o.count);
+            break;
+         case op_type::color: {
+            LogColorState color = o.color;
+            if (color.fg == LogColor::initial) {
+               color.fg = base.fg;
+            }
+            if (color.bg == LogColor::initial) {
+               color.bg = base.bg;
+            }
+            os << color;
+            break;
+         }
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Renders every line, each preceded by a newline, just as rendering
+///        the renderer tree the program was compiled from would.
+void LineProgram::render(std::ostream& os) const {
+   for (std::size_t line = 0, n = lines_.size(); line < n; ++line) {
+      os << nl;
+      render_line(os, line);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LineProgram::begin_line(I32 width) {
+   lines_.push_back(ops_.size());
+   width_ = width;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LineProgram::blank(U32 count) {
+   glyph(' ', count);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LineProgram::glyph(char glyph, U32 count) {
+   if (count == 0) {
+      return;
+   }
+
+   op_type type = glyph == ' ' ? op_type::blank : op_type::glyph;
+   if (ops_.size() > lines_.back()) {
+      op& prev = ops_.back();
+      if (prev.type == type && prev.glyph == glyph) {
+         prev.count += count;
+         return;
+      }
+   }
+
+   ops_.push_back({ type, glyph, LogColorState(), count, 0 });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LineProgram::text(std::string_view text) {
+   if (text.empty()) {
+      return;
+   }
+
+   if (std::all_of(text.begin(), text.end(), [](char c) { return c == ' '; })) {
+      blank((U32)text.size());
+      return;
+   }
+
+   U32 offset = (U32)text_.size();
+   text_.append(text.data(), text.size());
+
+   if (ops_.size() > lines_.back()) {
+      op& prev = ops_.back();
+      if (prev.type == op_type::text && prev.offset + prev.count == offset) {
+         prev.count += (U32)text.size();
+         return;
+      }
+   }
+
+   ops_.push_back({ op_type::text, 0, LogColorState(), (U32)text.size(), offset });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LineProgram::color(LogColorState color) {
+   if (ops_.size() > lines_.back()) {
+      op& prev = ops_.back();
+      if (prev.type == op_type::color) {
+         prev.color = color;
+         return;
+      }
+   }
+
+   ops_.push_back({ op_type::color, 0, color, 0, 0 });
+}
+
+namespace detail {
+
+///////////////////////////////////////////////////////////////////////////////
+LineProgramWriter::LineProgramWriter(LineProgram& program)
+   : program_(program),
+     color_ { LogColor::initial, LogColor::initial }
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+void LineProgramWriter::begin_line(I32 width) {
+   program_.begin_line(width);
+   color_ = { LogColor::initial, LogColor::initial };
+}
+
+///////////////////////////////////////////////////////////////////////////////
+LogColorState LineProgramWriter::color() const {
+   return color_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+LineProgramWriter& LineProgramWriter::operator<<(const S& text) {
+   program_.text(text);
+   return *this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+LineProgramWriter& LineProgramWriter::operator<<(char c) {
+   program_.glyph(c);
+   return *this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+LineProgramWriter& LineProgramWriter::operator<<(LogColorState color) {
+   LogColorState next = color_;
+   if (color.fg != LogColor::current) {
+      next.fg = color.fg;
+   }
+   if (color.bg != LogColor::current) {
+      next.bg = color.bg;
+   }
+
+   if (next.fg != color_.fg || next.bg != color_.bg) {
+      color_ = next;
+      program_.color(next);
+   }
+   return *this;
+}
+
+} // be::ct::detail
+} // be::ct
@@ -0,0 +1,80 @@
+#include "pch.hpp"
+#include "line_reader.hpp"
+#include "table_renderer.hpp"
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Sizes the table immediately; lines are rendered by next().
+LineReader::LineReader(const Table& table, I32 max_total_width, const EncoderConfig& config)
+   : renderer_(std::make_unique<detail::TableRenderer>(table)),
+     encoder_(config)
+{
+   renderer_->auto_size(max_total_width);
+   renderer_->combine_border_corners();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Applies a precomputed layout instead of sizing the table, so
+///        every reader given the same layout renders the same lines.
+LineReader::LineReader(const Table& table, const LayoutSnapshot& layout, const EncoderConfig& config)
+   : renderer_(std::make_unique<detail::TableRenderer>(table)),
+     encoder_(config)
+{
+   renderer_->apply_layout(layout);
+   renderer_->combine_border_corners();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+LineReader::~LineReader() { }
+
+///////////////////////////////////////////////////////////////////////////////
+I32 LineReader::width() const {
+   return renderer_->width();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Renders the next line into the internal buffer and points line at
+///        it.  Returns false once every line has been rendered.
+bool LineReader::next(std::string_view& line) {
+   if (!*renderer_) {
+      return false;
+   }
+
+   program_.clear();
+   detail::LineProgramWriter writer(program_);
+   writer.begin_line(renderer_->width());
+   (*renderer_)(writer);
+
+   buffer_.resize(encoder_.line_size(program_, 0));
+   encoder_.encode_line(program_, 0, &buffer_[0]);
+   line = buffer_;
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+LineReader::iterator LineReader::begin() {
+   return iterator(this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+LineReader::iterator LineReader::end() {
+   return iterator();
+}
+
+#ifdef BE_CTABLE_COROUTINES
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Renders a table lazily, as the returned generator is iterated.
+///        The table must outlive the generator.
+LineGenerator generate_lines(const Table& table, I32 max_total_width, EncoderConfig config) {
+   LineReader reader(table, max_total_width, config);
+   std::string_view line;
+   while (reader.next(line)) {
+      co_yield line;
+   }
+}
+
+#endif
+
+} // be::ct
@@ -0,0 +1,106 @@
+#include "pch.hpp"
+#include "live_display.hpp"
+#include <functional>
+#include <string_view>
+
+namespace be::ct {
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+void append_csi(S& out, std::size_t n, char command) {
+   out.append("\x1b[");
+   out.append(std::to_string(n));
+   out.push_back(command);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void move_to(S& out, std::size_t& row, std::size_t target) {
+   if (target < row) {
+      append_csi(out, row - target, 'A');
+   } else if (target > row) {
+      append_csi(out, target - row, 'B');
+   }
+   row = target;
+}
+
+} // be::ct::()
+
+///////////////////////////////////////////////////////////////////////////////
+LiveDisplay::LiveDisplay() { }
+
+///////////////////////////////////////////////////////////////////////////////
+LiveDisplay::LiveDisplay(const EncoderConfig& config)
+   : encoder_(config)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+const LineEncoder& LiveDisplay::encoder() const {
+   return encoder_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The number of lines in the previous frame.
+std::size_t LiveDisplay::lines() const {
+   return lines_.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Forgets the previous frame, so that the next update draws every
+///        line below the cursor.
+void LiveDisplay::reset() {
+   lines_.clear();
+   hashes_.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Appends the bytes needed to turn the previous frame into this one
+///        to out, leaving the cursor at the start of the line below it.
+void LiveDisplay::update(const LineProgram& program, S& out) {
+   std::size_t old_lines = lines_.size();
+   std::size_t new_lines = program.size();
+   std::size_t row = old_lines;
+
+   S line;
+   for (std::size_t i = 0; i < new_lines; ++i) {
+      line.resize(encoder_.line_size(program, i));
+      encoder_.encode_line(program, i, &line[0]);
+      std::size_t hash = std::hash<std::string_view>()(line);
+
+      if (i < old_lines) {
+         if (hashes_[i] == hash && lines_[i] == line) {
+            continue;
+         }
+         hashes_[i] = hash;
+         lines_[i].swap(line);
+      } else {
+         hashes_.push_back(hash);
+         lines_.push_back(line);
+      }
+
+      // clear the old line first, since the encoder may skip over blanks
+      move_to(out, row, i);
+      out.append("\r\x1b[K");
+      out.append(lines_[i]);
+      if (i >= old_lines) {
+         out.push_back('\n');
+         ++row;
+      }
+   }
+
+   move_to(out, row, new_lines);
+   out.push_back('\r');
+   if (new_lines < old_lines) {
+      out.append("\x1b[J");
+      lines_.resize(new_lines);
+      hashes_.resize(new_lines);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LiveDisplay::update(std::ostream& os, const LineProgram& program) {
+   S out;
+   update(program, out);
+   os.write(out.data(), out.size());
+}
+
+} // be::ct
@@ -0,0 +1,100 @@
+#include "pch.hpp"
+#include "live_layout.hpp"
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+LiveLayout::LiveLayout()
+   : shrink_threshold_(2),
+     shrink_frames_(10),
+     shrinkable_frames_(0),
+     max_total_width_(-1),
+     layouts_(0)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+LiveLayout::LiveLayout(I32 shrink_threshold, U32 shrink_frames)
+   : shrink_threshold_(shrink_threshold),
+     shrink_frames_(shrink_frames),
+     shrinkable_frames_(0),
+     max_total_width_(-1),
+     layouts_(0)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+I32 LiveLayout::shrink_threshold() const {
+   return shrink_threshold_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LiveLayout::shrink_threshold(I32 threshold) {
+   shrink_threshold_ = threshold;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+U32 LiveLayout::shrink_frames() const {
+   return shrink_frames_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LiveLayout::shrink_frames(U32 frames) {
+   shrink_frames_ = frames;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The layout used for the most recent frame.  Row heights are not
+///        retained.
+const LayoutSnapshot& LiveLayout::layout() const {
+   return layout_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The number of frames which required the table to be laid out.
+std::size_t LiveLayout::layouts() const {
+   return layouts_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Forces the next frame to be laid out.
+void LiveLayout::reset() {
+   shrinkable_frames_ = 0;
+   max_total_width_ = -1;
+   pref_widths_.clear();
+   layout_ = LayoutSnapshot();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool LiveLayout::needs_layout_(I32 max_total_width, const std::vector<I32>& pref_widths) {
+   if (max_total_width != max_total_width_ || pref_widths.size() != pref_widths_.size() || layouts_ == 0) {
+      return true;
+   }
+
+   bool shrinkable = false;
+   for (std::size_t i = 0, n = pref_widths.size(); i < n; ++i) {
+      if (pref_widths[i] > pref_widths_[i]) {
+         return true;
+      } else if (pref_widths_[i] - pref_widths[i] > shrink_threshold_) {
+         shrinkable = true;
+      }
+   }
+
+   if (!shrinkable) {
+      shrinkable_frames_ = 0;
+      return false;
+   }
+
+   ++shrinkable_frames_;
+   return shrinkable_frames_ >= shrink_frames_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LiveLayout::record_(I32 max_total_width, std::vector<I32> pref_widths, const LayoutSnapshot& layout) {
+   shrinkable_frames_ = 0;
+   max_total_width_ = max_total_width;
+   pref_widths_ = std::move(pref_widths);
+   layout_ = layout;
+   layout_.rows.clear();
+   ++layouts_;
+}
+
+} // be::ct
@@ -0,0 +1,196 @@
+#include "pch.hpp"
+#include "mapped_file.hpp"
+#include "line_reader.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace be::ct {
+namespace {
+
+#ifdef _WIN32
+
+///////////////////////////////////////////////////////////////////////////////
+[[noreturn]] void throw_last_error(const char* what) {
+   throw std::system_error((int)GetLastError(), std::system_category(), what);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+class Handle final : Immovable {
+public:
+   explicit Handle(HANDLE handle) : handle_(handle) { }
+   ~Handle() {
+      if (handle_ && handle_ != INVALID_HANDLE_VALUE) {
+         CloseHandle(handle_);
+      }
+   }
+
+   HANDLE get() const { return handle_; }
+
+private:
+   HANDLE handle_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+class View final : Immovable {
+public:
+   explicit View(void* ptr) : ptr_(ptr) { }
+   ~View() {
+      if (ptr_) {
+         UnmapViewOfFile(ptr_);
+      }
+   }
+
+   char* get() const { return static_cast<char*>(ptr_); }
+
+private:
+   void* ptr_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Encode>
+void write_file(const S& path, std::size_t size, Encode encode) {
+   Handle file(CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+   if (file.get() == INVALID_HANDLE_VALUE) {
+      throw_last_error("Could not create output file!");
+   }
+
+   if (size == 0) {
+      return;
+   }
+
+   U64 size64 = size;
+   Handle mapping(CreateFileMappingA(file.get(), nullptr, PAGE_READWRITE, (DWORD)(size64 >> 32), (DWORD)size64, nullptr));
+   if (!mapping.get()) {
+      throw_last_error("Could not map output file!");
+   }
+
+   View view(MapViewOfFile(mapping.get(), FILE_MAP_WRITE, 0, 0, size));
+   if (!view.get()) {
+      throw_last_error("Could not map output file!");
+   }
+
+   encode(view.get());
+}
+
+#else
+
+///////////////////////////////////////////////////////////////////////////////
+[[noreturn]] void throw_errno(const char* what) {
+   throw std::system_error(errno, std::generic_category(), what);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+class FileDescriptor final : Immovable {
+public:
+   explicit FileDescriptor(int fd) : fd_(fd) { }
+   ~FileDescriptor() {
+      if (fd_ >= 0) {
+         close(fd_);
+      }
+   }
+
+   int get() const { return fd_; }
+
+private:
+   int fd_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+class Mapping final : Immovable {
+public:
+   Mapping(void* ptr, std::size_t size) : ptr_(ptr), size_(size) { }
+   ~Mapping() {
+      if (ptr_ != MAP_FAILED) {
+         munmap(ptr_, size_);
+      }
+   }
+
+   char* get() const { return ptr_ == MAP_FAILED ? nullptr : static_cast<char*>(ptr_); }
+
+private:
+   void* ptr_;
+   std::size_t size_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Encode>
+void write_file(const S& path, std::size_t size, Encode encode) {
+   FileDescriptor file(open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0666));
+   if (file.get() < 0) {
+      throw_errno("Could not create output file!");
+   }
+
+   if (size == 0) {
+      return;
+   }
+
+   if (ftruncate(file.get(), (off_t)size) != 0) {
+      throw_errno("Could not resize output file!");
+   }
+
+   Mapping mapping(mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file.get(), 0), size);
+   if (!mapping.get()) {
+      throw_errno("Could not map output file!");
+   }
+
+   encode(mapping.get());
+}
+
+#endif
+
+} // be::ct::()
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Creates (or replaces) the file at path, sized to exactly fit the
+///        encoded program, and encodes the program directly into a memory
+///        mapping of it.
+void write_mapped_file(const S& path, const LineProgram& program, const LineEncoder& encoder) {
+   write_file(path, encoder.size(program), [&](char* out) {
+      encoder.encode(program, out);
+   });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Creates (or replaces) the file at path and writes the table to it,
+///        sized to max_total_width, without compiling the whole table.
+///
+/// \details The table is rendered twice, one line at a time: once to find
+///         the file's size, and again to write each line into the mapping.
+///         The table is only sized once, and both passes use that layout,
+///         so they produce the same lines even when sizing is time-limited
+///         (see TableConfig::line_count_budget_ms).
+void write_mapped_file(const S& path, const Table& table, I32 max_total_width, const LineEncoder& encoder) {
+   const LayoutSnapshot table_layout = layout(table, max_total_width);
+
+   std::size_t size = 0;
+   for (std::string_view line : LineReader(table, table_layout, encoder.config())) {
+      size += line.size() + 1;
+   }
+
+   write_file(path, size, [&](char* out) {
+      char* end = out + size;
+      for (std::string_view line : LineReader(table, table_layout, encoder.config())) {
+         if (line.size() >= (std::size_t)(end - out)) {
+            throw std::invalid_argument("Table rendered to more bytes than it was measured at!");
+         }
+         std::memcpy(out, line.data(), line.size());
+         out += line.size();
+         *out++ = '\n';
+      }
+      if (out != end) {
+         throw std::invalid_argument("Table rendered to fewer bytes than it was measured at!");
+      }
+   });
+}
+
+} // be::ct
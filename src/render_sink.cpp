@@ -0,0 +1,52 @@
+#include "pch.hpp"
+#include "render_sink.hpp"
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+RenderSink console_sink(std::ostream& os) {
+   return RenderSink { os, true, EncoderConfig() };
+}
+
+///////////////////////////////////////////////////////////////////////////////
+RenderSink ansi_sink(std::ostream& os, const EncoderConfig& config) {
+   return RenderSink { os, false, config };
+}
+
+///////////////////////////////////////////////////////////////////////////////
+RenderSink plain_sink(std::ostream& os) {
+   EncoderConfig config;
+   config.color = false;
+   return RenderSink { os, false, config };
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Lays out and renders a table once, writing each line to every
+///        sink in turn.
+void render(const Table& table, I32 max_total_width, const std::vector<RenderSink>& sinks) {
+   LineProgram program = compile(table, max_total_width);
+
+   std::vector<LineEncoder> encoders;
+   encoders.reserve(sinks.size());
+   for (const RenderSink& sink : sinks) {
+      encoders.emplace_back(sink.encoder);
+   }
+
+   S buffer;
+   for (std::size_t line = 0, n = program.size(); line < n; ++line) {
+      for (std::size_t i = 0; i < sinks.size(); ++i) {
+         std::ostream& os = sinks[i].os;
+         if (sinks[i].stream_colors) {
+            os << nl;
+            program.render_line(os, line);
+         } else {
+            buffer.resize(encoders[i].line_size(program, line));
+            encoders[i].encode_line(program, line, &buffer[0]);
+            buffer.push_back('\n');
+            os.write(buffer.data(), buffer.size());
+         }
+      }
+   }
+}
+
+} // be::ct
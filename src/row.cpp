@@ -1,6 +1,7 @@
 #include "pch.hpp"
 #include "row.hpp"
 #include "row_renderer.hpp"
+#include "content_hash.hpp"
 
 namespace be::ct {
 
@@ -147,6 +148,19 @@ const RowConfig& Row::config() const {
    return config_;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Returns a hash of the row's cells and the parts of its config
+///        which affect its size.
+U64 Row::hash() const {
+   U64 hash = detail::hash_value(detail::content_hash_basis, is_header_);
+   hash = detail::hash_box_config(hash, config_.box);
+   hash = detail::hash_value(hash, cells_.size());
+   for (const Cell& c : cells_) {
+      hash = detail::hash_value(hash, c.hash());
+   }
+   return hash;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void cell(Row& row) {
    row.push_back();
@@ -0,0 +1,104 @@
+#include "pch.hpp"
+#include "row_queue.hpp"
+#include <stdexcept>
+#include <thread>
+
+namespace be::ct {
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t round_capacity(std::size_t capacity) {
+   if (capacity < 2) {
+      throw std::invalid_argument("RowQueue capacity must be at least 2!");
+   }
+
+   std::size_t rounded = 2;
+   while (rounded < capacity) {
+      rounded <<= 1;
+   }
+   return rounded;
+}
+
+} // be::ct::()
+
+///////////////////////////////////////////////////////////////////////////////
+RowQueue::RowQueue(std::size_t capacity, overflow_policy policy)
+   : mask_(round_capacity(capacity) - 1),
+     slots_(std::make_unique<slot[]>(mask_ + 1)),
+     policy_(policy),
+     enqueue_pos_(0),
+     dequeue_pos_(0),
+     dropped_(0)
+{
+   for (std::size_t i = 0; i <= mask_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t RowQueue::capacity() const {
+   return mask_ + 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+RowQueue::overflow_policy RowQueue::policy() const {
+   return policy_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The number of rows discarded because the queue was full.
+U64 RowQueue::dropped() const {
+   return dropped_.load(std::memory_order_relaxed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Adds a row to the queue.  Safe to call from any thread.  Returns
+///        false if the row was dropped because the queue was full.
+bool RowQueue::push(Row row) {
+   std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+   slot* s;
+   for (;;) {
+      s = &slots_[pos & mask_];
+      std::size_t seq = s->sequence.load(std::memory_order_acquire);
+      std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+      if (diff == 0) {
+         if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            break;
+         }
+      } else if (diff < 0) {
+         // the slot still holds a row from the previous lap; the queue is full
+         if (policy_ == overflow_policy::drop) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+         }
+         std::this_thread::yield();
+         pos = enqueue_pos_.load(std::memory_order_relaxed);
+      } else {
+         pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+   }
+
+   s->row = std::move(row);
+   s->sequence.store(pos + 1, std::memory_order_release);
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Removes the oldest row from the queue, if there is one.  Must
+///        only be called from one thread at a time.
+bool RowQueue::try_pop(Row& row) {
+   std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+   slot& s = slots_[pos & mask_];
+   std::size_t seq = s.sequence.load(std::memory_order_acquire);
+   if ((std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + 1) < 0) {
+      return false;
+   }
+
+   row = std::move(s.row);
+   s.row = Row();
+   dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+   s.sequence.store(pos + mask_ + 1, std::memory_order_release);
+   return true;
+}
+
+} // be::ct
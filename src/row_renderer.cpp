@@ -1,5 +1,6 @@
 #include "pch.hpp"
 #include "row_renderer.hpp"
+#include "box_state.hpp"
 #include "table_sizer.hpp"
 #include <memory>
 
@@ -7,14 +8,9 @@ namespace be::ct {
 namespace detail {
 namespace {
 
-///////////////////////////////////////////////////////////////////////////////
-U8 get_margin(const BorderConfig& config) {
-   return config.margin > 0 ? config.margin - 1 : 0;
-}
-
 ///////////////////////////////////////////////////////////////////////////////
 U8 get_margin(const Row& row, BoxConfig::side side) {
-   return get_margin(row.config().box.sides[side]);
+   return border_margin(row.config().box.sides[side]);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -41,15 +37,15 @@ RowRenderer::RowRenderer(const Row& row)
             get_margin(row, BoxConfig::bottom_side),
             get_margin(row, BoxConfig::left_side)),
      config_(row.config().box),
+     undecorated_(false),
      align_(row.config().box.align)
 {
+   margin.parent(*this);
+
    border.foreground(row.config().box.foreground);
    border.background(row.config().box.background);
 
-   try_add_border_(BoxConfig::top_side);
-   try_add_border_(BoxConfig::right_side);
-   try_add_border_(BoxConfig::bottom_side);
-   try_add_border_(BoxConfig::left_side);
+   add_box_borders(border, config_);
 
    cells_.reserve(row.size());
    for (const Cell& cell : row) {
@@ -95,6 +91,8 @@ void RowRenderer::combine_border_corners() {
             bc = config_.corners(bc, border.right().back(), BoxConfig::bottom_side, BoxConfig::right_side);
          }
       }
+
+      border.prepare();
    }
 }
 
@@ -108,6 +106,13 @@ U8 RowRenderer::align() const {
    return align_;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void RowRenderer::output_cache(CellOutputCache* cache) {
+   for (auto& cell : cells_) {
+      cell->text.output_cache(cache);
+   }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 I32 RowRenderer::width_() const {
    return margin.width();
@@ -118,6 +123,16 @@ I32 RowRenderer::height_() const {
    return margin.height();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief True if there are no margins, borders, padding, or box colors, in
+///        which case rendering can skip straight to the sequence.
+bool RowRenderer::is_undecorated_() const {
+   return config_.foreground == LogColor::current &&
+      config_.background == LogColor::current &&
+      margin.width() == seq.width() &&
+      margin.height() == seq.height();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void RowRenderer::freeze_() {
    bool first_freeze = cached_width_ == -1;
@@ -141,20 +156,19 @@ void RowRenderer::freeze_() {
       generate_border_(BoxConfig::right_side);
       generate_border_(BoxConfig::bottom_side);
       generate_border_(BoxConfig::left_side);
+      border.prepare();
    }
+   undecorated_ = is_undecorated_();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void RowRenderer::render_(std::ostream& os) {
-   margin(os);
-}
-
-///////////////////////////////////////////////////////////////////////////////
-void RowRenderer::try_add_border_(BoxConfig::side side) {
-   if (config_.sides[side].margin > 0) {
-      border.enabled(side, true);
-      border.top().emplace_back();
-   }
+/// \brief Restores the margins, padding, and borders that sizing may have
+///        trimmed, so that a new size can be applied.
+void RowRenderer::thaw_() {
+   margin.thaw();
+   base::thaw_();
+   undecorated_ = false;
+   restore_box(*this, config_);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -165,7 +179,7 @@ void RowRenderer::generate_border_(BoxConfig::side side) {
       std::size_t size = 2 + (side == BoxConfig::top_side || side == BoxConfig::bottom_side ?
                               padding.width() : padding.height());
 
-      b = expand_border_pattern(pattern, size);
+      expand_border_pattern(pattern, size, b);
       resolve_border_colors_(side);
    }
 }
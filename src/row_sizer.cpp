@@ -9,11 +9,12 @@ namespace detail {
 RowSizer::RowSizer(RowRenderer& row)
    : row_(&row),
      top_external_height_(0),
-     bottom_external_height_(0),
-     pref_internal_height_(0),
-     min_internal_height_(0),
-     max_internal_height_(std::numeric_limits<I32>::max())
+     bottom_external_height_(0)
 {
+   I32 pref_internal_height = 0;
+   I32 min_internal_height = 0;
+   I32 max_internal_height = std::numeric_limits<I32>::max();
+
    for (auto& ptr : row.cells_) {
       CellRenderer& cell = *ptr;
 
@@ -27,21 +28,29 @@ RowSizer::RowSizer(RowRenderer& row)
 
       top_external_height_ = max(top_external_height_, top_external);
       bottom_external_height_ = max(bottom_external_height_, bottom_external);
-      pref_internal_height_ = max(pref_internal_height_, pref_internal);
-      min_internal_height_ = max(min_internal_height_, min_internal);
-      max_internal_height_ = min(max_internal_height_, max_internal);
-      max_internal_height_ = max(max_internal_height_, min_internal_height_);
+      pref_internal_height = max(pref_internal_height, pref_internal);
+      min_internal_height = max(min_internal_height, min_internal);
+      max_internal_height = min(max_internal_height, max_internal);
+      max_internal_height = max(max_internal_height, min_internal_height);
    }
+
+   internal_height_ = clamp(pref_internal_height, min_internal_height, max_internal_height);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void RowSizer::set_heights() {
-   I32 internal_height = clamp(pref_internal_height_, min_internal_height_, max_internal_height_);
+RowSizer::RowSizer(RowRenderer& row, const RowLayout& layout)
+   : row_(&row),
+     top_external_height_(layout.top_external),
+     bottom_external_height_(layout.bottom_external),
+     internal_height_(layout.internal_height)
+{ }
 
+///////////////////////////////////////////////////////////////////////////////
+void RowSizer::set_heights() {
    for (auto& ptr : row_->cells_) {
       CellRenderer& cell = *ptr;
 
-      I32 text_height = internal_height - (cell.padding.top() + cell.padding.bottom());
+      I32 text_height = internal_height_ - (cell.padding.top() + cell.padding.bottom());
 
       while (text_height < 0) {
          auto& p = cell.padding;
@@ -78,5 +87,14 @@ void RowSizer::set_heights() {
    }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+RowLayout RowSizer::layout() const {
+   RowLayout layout;
+   layout.top_external = top_external_height_;
+   layout.bottom_external = bottom_external_height_;
+   layout.internal_height = internal_height_;
+   return layout;
+}
+
 } // be::ct::detail
 } // be::ct
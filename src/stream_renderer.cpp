@@ -0,0 +1,70 @@
+#include "pch.hpp"
+#include "stream_renderer.hpp"
+#include "table_renderer.hpp"
+
+namespace be::ct {
+
+///////////////////////////////////////////////////////////////////////////////
+StreamRenderer::StreamRenderer(std::ostream& os, TableConfig config, I32 max_total_width)
+   : os_(os),
+     config_(std::move(config)),
+     max_total_width_(max_total_width),
+     rows_(0)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The number of rows written so far.
+U64 StreamRenderer::rows() const {
+   return rows_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Renders a batch of rows below those written previously.
+void StreamRenderer::write(std::vector<Row> rows) {
+   write_(rows);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Pops up to max_rows rows from queue and renders them as a single
+///        batch.  Returns the number of rows rendered.  This must be the
+///        only consumer of queue.
+std::size_t StreamRenderer::drain(RowQueue& queue, std::size_t max_rows) {
+   Row row;
+   while (batch_.size() < max_rows && queue.try_pop(row)) {
+      batch_.push_back(std::move(row));
+   }
+
+   std::size_t n = batch_.size();
+   write_(batch_);
+   batch_.clear();
+   return n;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void StreamRenderer::write_(std::vector<Row>& rows) {
+   if (rows.empty()) {
+      return;
+   }
+
+   Table table(config_);
+   table.reserve(rows.size());
+   bool sketch = config_.pref_width_percentile < 100;
+   for (Row& row : rows) {
+      add_column_stats(stats_, row, sketch);
+      table.push_back(std::move(row));
+   }
+
+   detail::TableRenderer r(table);
+   r.column_stats(stats_);
+   r.auto_size(max_total_width_, live_);
+   r.combine_border_corners();
+   while (r) {
+      os_ << nl;
+      r(os_);
+   }
+   os_.flush();
+
+   rows_ += rows.size();
+}
+
+} // be::ct
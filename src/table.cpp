@@ -1,19 +1,28 @@
 #include "pch.hpp"
 #include "table.hpp"
 #include "table_renderer.hpp"
+#include "content_hash.hpp"
 
 namespace be::ct {
 
 ///////////////////////////////////////////////////////////////////////////////
-Table::Table() { }
+Table::Table()
+   : track_column_stats_(false),
+     sealed_(false),
+     column_stats_rows_(0)
+{ }
 
 ///////////////////////////////////////////////////////////////////////////////
-Table::Table(TableConfig config) :
-   config_(std::move(config))
+Table::Table(TableConfig config)
+   : config_(std::move(config)),
+     track_column_stats_(false),
+     sealed_(false),
+     column_stats_rows_(0)
 { }
 
 ///////////////////////////////////////////////////////////////////////////////
 Table::iterator Table::begin() {
+   invalidate_column_stats();
    return rows_.begin();
 }
 
@@ -24,6 +33,7 @@ Table::const_iterator Table::begin() const {
 
 ///////////////////////////////////////////////////////////////////////////////
 Table::iterator Table::end() {
+   invalidate_column_stats();
    return rows_.end();
 }
 
@@ -34,6 +44,7 @@ Table::const_iterator Table::end() const {
 
 ///////////////////////////////////////////////////////////////////////////////
 Row& Table::operator[](std::size_t index) {
+   invalidate_column_stats();
    return rows_[index];
 }
 
@@ -53,7 +64,10 @@ std::size_t Table::size() const {
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+/// \brief Doesn't invalidate column_stats(), since the last row is always
+///        measured again anyway; this keeps appending cells cheap.
 Row& Table::back() {
+   sealed_ = false;
    return rows_.back();
 }
 
@@ -69,6 +83,7 @@ void Table::reserve(std::size_t capacity) {
 
 ///////////////////////////////////////////////////////////////////////////////
 Table::iterator Table::insert_header(iterator where) {
+   invalidate_column_stats();
    std::size_t count = config_.headers.size();
    if (count == 0) {
       return rows_.insert(where, Row(RowConfig(), true));
@@ -89,6 +104,7 @@ Table::iterator Table::insert_header(iterator where) {
 
 ///////////////////////////////////////////////////////////////////////////////
 Table::iterator Table::insert(iterator where) {
+   invalidate_column_stats();
    std::size_t count = config_.rows.size();
    if (count == 0) {
       return rows_.insert(where, Row(RowConfig(), false));
@@ -109,11 +125,13 @@ Table::iterator Table::insert(iterator where) {
 
 ///////////////////////////////////////////////////////////////////////////////
 Table::iterator Table::insert(iterator where, Row row) {
+   invalidate_column_stats();
    return rows_.insert(where, std::move(row));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 void Table::push_back_header() {
+   sealed_ = false;
    std::size_t count = config_.headers.size();
    if (count == 0) {
       rows_.push_back(Row(RowConfig(), true));
@@ -135,6 +153,7 @@ void Table::push_back_header() {
 
 ///////////////////////////////////////////////////////////////////////////////
 void Table::push_back() {
+   sealed_ = false;
    std::size_t count = config_.rows.size();
    if (count == 0) {
       rows_.push_back(Row(RowConfig(), false));
@@ -156,11 +175,13 @@ void Table::push_back() {
 
 ///////////////////////////////////////////////////////////////////////////////
 void Table::push_back(Row row) {
+   sealed_ = false;
    rows_.push_back(std::move(row));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 TableConfig& Table::config() {
+   invalidate_column_stats();
    return config_;
 }
 
@@ -169,6 +190,112 @@ const TableConfig& Table::config() const {
    return config_;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Returns a hash of the table's rows and the parts of its config
+///        which affect its layout; tables with equal hashes can share a
+///        LayoutSnapshot.
+U64 Table::hash() const {
+   U64 hash = detail::hash_box_config(detail::content_hash_basis, config_.box);
+   hash = detail::hash_value(hash, config_.pref_width_percentile);
+   hash = detail::hash_value(hash, config_.line_count_budget_ms);
+   hash = detail::hash_value(hash, rows_.size());
+   for (const Row& r : rows_) {
+      hash = detail::hash_value(hash, r.hash());
+   }
+   return hash;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Cleans every cell and computes column_stats(), so that const
+///        member functions no longer modify any part of the table.
+///
+/// \details A sealed table can be laid out and rendered by any number of
+///         threads at once without locking.  Any non-const access to the
+///         table unseals it; cells must not be modified through references
+///         obtained before sealing while it is being rendered.
+void Table::seal() {
+   for (const Row& row : rows_) {
+      for (const Cell& cell : row) {
+         cell.clean();
+      }
+   }
+   column_stats();
+   sealed_ = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool Table::sealed() const {
+   return sealed_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Enables or disables incremental maintenance of column_stats().
+///
+/// \details When enabled, rows are measured once and folded into the stored
+///         aggregates as soon as a later row is added; only the last row,
+///         which may still be receiving cells, is re-measured on each call to
+///         column_stats().  Non-const access through operator[], iterators,
+///         or config() discards the aggregates, since earlier rows or the
+///         width policy may be changed through them.  References to earlier
+///         rows kept from before later rows were added must not be used to
+///         modify them without calling invalidate_column_stats().
+void Table::track_column_stats(bool enabled) {
+   track_column_stats_ = enabled;
+   invalidate_column_stats();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool Table::tracking_column_stats() const {
+   return track_column_stats_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const std::vector<ColumnStats>& Table::column_stats() const {
+   if (sealed_) {
+      return column_stats_;
+   }
+
+   if (!track_column_stats_) {
+      column_stats_.clear();
+      for (const Row& row : rows_) {
+         add_column_stats(column_stats_, row, config_.pref_width_percentile < 100);
+      }
+      return column_stats_;
+   }
+
+   std::size_t sealed_rows = rows_.empty() ? 0 : rows_.size() - 1;
+   if (column_stats_rows_ > sealed_rows) {
+      column_stats_rows_ = 0;
+      sealed_column_stats_.clear();
+   }
+
+   for (; column_stats_rows_ < sealed_rows; ++column_stats_rows_) {
+      add_column_stats(sealed_column_stats_, rows_[column_stats_rows_], config_.pref_width_percentile < 100);
+   }
+
+   column_stats_ = sealed_column_stats_;
+   if (!rows_.empty()) {
+      add_column_stats(column_stats_, rows_.back(), config_.pref_width_percentile < 100);
+   }
+
+   return column_stats_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void Table::invalidate_column_stats() {
+   sealed_ = false;
+   column_stats_rows_ = 0;
+   sealed_column_stats_.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Seals a table and hands it over to shared, read-only ownership,
+///        suitable for rendering from many threads concurrently.
+std::shared_ptr<const Table> seal(Table table) {
+   table.seal();
+   return std::make_shared<const Table>(std::move(table));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void row(Table& table) {
    table.push_back();
@@ -287,4 +414,88 @@ std::ostream& operator<<(std::ostream& os, const Table& table) {
    return os;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Sizes a table without rendering it.  The result can be passed to
+///        render() as long as the table's rows and columns are not added or
+///        removed in the meantime.
+LayoutSnapshot layout(const Table& table, I32 max_total_width) {
+   detail::TableRenderer r(table);
+   r.auto_size(max_total_width);
+   return r.layout();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Renders a table using a precomputed layout; cells are not measured.
+void render(std::ostream& os, const Table& table, const LayoutSnapshot& layout) {
+   detail::TableRenderer r(table);
+   r.apply_layout(layout);
+   r.combine_border_corners();
+   while (r) {
+      os << nl;
+      r(os);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Renders one frame of a live-updating table, reusing the column
+///        widths of the previous frame where possible.
+void render(std::ostream& os, const Table& table, LiveLayout& layout) {
+   detail::TableRenderer r(table);
+   r.auto_size(console_width(os) - 1, layout);
+   r.combine_border_corners();
+   while (r) {
+      os << nl;
+      r(os);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Renders a table, reusing the layout of a previously rendered table
+///        with the same content, if cache has one.
+void render(std::ostream& os, const Table& table, LayoutCache& cache) {
+   detail::TableRenderer r(table);
+   r.auto_size(console_width(os) - 1, table.hash(), cache);
+   r.combine_border_corners();
+   while (r) {
+      os << nl;
+      r(os);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Renders a table like render(std::ostream&, const Table&,
+///        LayoutCache&), but also replays the output of any cells which
+///        were rendered previously with the same content and size.
+void render(std::ostream& os, const Table& table, LayoutCache& layouts, CellOutputCache& cells) {
+   detail::TableRenderer r(table);
+   r.output_cache(&cells);
+   r.auto_size(console_width(os) - 1, table.hash(), layouts);
+   r.combine_border_corners();
+   while (r) {
+      os << nl;
+      r(os);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Redraws a live-updating table in place, reusing the column widths
+///        of the previous frame where possible and writing only the lines
+///        which changed.
+void render(std::ostream& os, const Table& table, LiveLayout& layout, LiveDisplay& display) {
+   detail::TableRenderer r(table);
+   r.auto_size(console_width(os) - 1, layout);
+   r.combine_border_corners();
+   display.update(os, r.compile());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Sizes a table and compiles it into a LineProgram, which can be
+///        rendered repeatedly without walking the renderer tree.
+LineProgram compile(const Table& table, I32 max_total_width) {
+   detail::TableRenderer r(table);
+   r.auto_size(max_total_width);
+   r.combine_border_corners();
+   return r.compile();
+}
+
 } // be::ct
@@ -1,5 +1,6 @@
 #include "pch.hpp"
 #include "table_renderer.hpp"
+#include "box_state.hpp"
 #include "table_sizer.hpp"
 #include <memory>
 
@@ -7,14 +8,9 @@ namespace be::ct {
 namespace detail {
 namespace {
 
-///////////////////////////////////////////////////////////////////////////////
-U8 get_margin(const BorderConfig& config) {
-   return config.margin > 0 ? config.margin - 1 : 0;
-}
-
 ///////////////////////////////////////////////////////////////////////////////
 U8 get_margin(const Table& table, BoxConfig::side side) {
-   return get_margin(table.config().box.sides[side]);
+   return border_margin(table.config().box.sides[side]);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -41,15 +37,18 @@ TableRenderer::TableRenderer(const Table& table)
             get_margin(table, BoxConfig::bottom_side),
             get_margin(table, BoxConfig::left_side)),
      config_(table.config().box),
-     align_(table.config().box.align)
+     undecorated_(false),
+     align_(table.config().box.align),
+     column_stats_(table.tracking_column_stats() ? &table.column_stats() : nullptr),
+     pref_width_percentile_(table.config().pref_width_percentile),
+     line_count_budget_ms_(table.config().line_count_budget_ms)
 {
+   margin.parent(*this);
+
    border.foreground(table.config().box.foreground);
    border.background(table.config().box.background);
 
-   try_add_border_(BoxConfig::top_side);
-   try_add_border_(BoxConfig::right_side);
-   try_add_border_(BoxConfig::bottom_side);
-   try_add_border_(BoxConfig::left_side);
+   add_box_borders(border, config_);
 
    rows_.reserve(table.size());
    for (const Row& row : table) {
@@ -59,34 +58,96 @@ TableRenderer::TableRenderer(const Table& table)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+TableRenderer::~TableRenderer() { }
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Sizes the table to fit within max_total_width.
+///
+/// \details Cells are only measured the first time; calling auto_size()
+///         again (e.g. when the console is resized) redistributes the
+///         cached measurements and only re-wraps columns whose width
+///         changed.  combine_border_corners() must be called again before
+///         rendering.
 void TableRenderer::auto_size(I32 max_total_width) {
-   I32 max_row_width = max_total_width;
-   max_row_width -= margin.left() + margin.right();
-   max_row_width -= padding.left() + padding.right();
-   if (border.enabled(BoxConfig::left_side)) --max_row_width;
-   if (border.enabled(BoxConfig::right_side)) --max_row_width;
-   while (max_row_width < 0) {
-      if (margin.left() <= 1u && margin.right() <= 1u && (padding.left() > 0u || padding.right() > 0u)) {
-         if (padding.right() > padding.left()) {
-            padding.right(padding.right() - 1u);
-         } else {
-            padding.left(padding.left() - 1u);
-         }
-      } else {
-         if (margin.right() > margin.left()) {
-            margin.right(margin.right() - 1u);
-         } else if (margin.left() > 0u) {
-            margin.left(margin.left() - 1u);
-         }
-      }
-      ++max_row_width;
+   thaw();
+   I32 max_row_width = fit_box_(max_total_width);
+   measure_();
+   sizer_->set_sizes(max_row_width);
+   record_layout_();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Sizes the table like auto_size(I32), but keeps the column widths
+///        used for the previous frame unless live decides that they are
+///        no longer appropriate.
+void TableRenderer::auto_size(I32 max_total_width, LiveLayout& live) {
+   thaw();
+   I32 max_row_width = fit_box_(max_total_width);
+   measure_();
+
+   std::vector<I32> pref_widths = sizer_->pref_internal_widths();
+   if (live.needs_layout_(max_total_width, pref_widths)) {
+      sizer_->set_sizes(max_row_width);
+      record_layout_();
+      live.record_(max_total_width, std::move(pref_widths), layout_);
+   } else {
+      sizer_->set_sizes(live.layout_);
+      record_layout_();
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Sizes the table like auto_size(I32), but uses the layout cached
+///        for table_hash (see Table::hash()) and max_total_width instead of
+///        measuring cells, if there is one.
+void TableRenderer::auto_size(I32 max_total_width, U64 table_hash, LayoutCache& cache) {
+   if (const LayoutSnapshot* cached = cache.find(table_hash, max_total_width)) {
+      apply_layout(*cached);
+   } else {
+      auto_size(max_total_width);
+      cache.insert(table_hash, max_total_width, layout_);
    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Sizes the table using a layout recorded by a previous call to
+///        auto_size() instead of measuring cells.
+void TableRenderer::apply_layout(const LayoutSnapshot& layout) {
+   thaw();
+
+   margin.left(layout.margin_left);
+   margin.right(layout.margin_right);
+   padding.left(layout.padding_left);
+   padding.right(layout.padding_right);
 
    TableSizer sizer(rows_.size());
+   sizer.skip_measurement();
    for (auto& row : rows_) {
       sizer.add(*row);
    }
-   sizer.set_sizes(max_row_width);
+   sizer.set_sizes(layout);
+
+   layout_ = layout;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const LayoutSnapshot& TableRenderer::layout() const {
+   return layout_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Renders the remaining lines into a LineProgram instead of a
+///        stream.  combine_border_corners() should be called first.
+LineProgram TableRenderer::compile() {
+   freeze();
+
+   LineProgram program;
+   LineProgramWriter writer(program);
+   while (*this) {
+      writer.begin_line(width());
+      (*this)(writer);
+   }
+   return program;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -119,9 +180,83 @@ void TableRenderer::combine_border_corners() {
             bc = config_.corners(bc, border.right().back(), BoxConfig::bottom_side, BoxConfig::right_side);
          }
       }
+
+      border.prepare();
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Shares cache between the text renderers of every cell, so that
+///        unchanged cells are not formatted again.  The cache must outlive
+///        this renderer.
+void TableRenderer::output_cache(CellOutputCache* cache) {
+   for (auto& row : rows_) {
+      row->output_cache(cache);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Sizes columns using the given stats instead of measuring cells,
+///        as when the table is tracking its column stats.  The stats may
+///        include rows which aren't in this table, and must outlive this
+///        renderer.
+void TableRenderer::column_stats(const std::vector<ColumnStats>& stats) {
+   column_stats_ = &stats;
+   sizer_.reset();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Trims the table's margins and padding if necessary to fit within
+///        max_total_width, and returns the width available for rows.
+I32 TableRenderer::fit_box_(I32 max_total_width) {
+   I32 max_row_width = max_total_width;
+   max_row_width -= margin.left() + margin.right();
+   max_row_width -= padding.left() + padding.right();
+   if (border.enabled(BoxConfig::left_side)) --max_row_width;
+   if (border.enabled(BoxConfig::right_side)) --max_row_width;
+   while (max_row_width < 0) {
+      if (margin.left() <= 1u && margin.right() <= 1u && (padding.left() > 0u || padding.right() > 0u)) {
+         if (padding.right() > padding.left()) {
+            padding.right(padding.right() - 1u);
+         } else {
+            padding.left(padding.left() - 1u);
+         }
+      } else {
+         if (margin.right() > margin.left()) {
+            margin.right(margin.right() - 1u);
+         } else if (margin.left() > 0u) {
+            margin.left(margin.left() - 1u);
+         }
+      }
+      ++max_row_width;
+   }
+   return max_row_width;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TableRenderer::measure_() {
+   if (!sizer_) {
+      sizer_ = std::make_unique<TableSizer>(rows_.size());
+      sizer_->pref_width_percentile(pref_width_percentile_);
+      sizer_->line_count_budget(line_count_budget_ms_);
+      if (column_stats_) {
+         sizer_->column_stats(*column_stats_);
+      }
+      for (auto& row : rows_) {
+         sizer_->add(*row);
+      }
    }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void TableRenderer::record_layout_() {
+   layout_.margin_left = margin.left();
+   layout_.margin_right = margin.right();
+   layout_.padding_left = padding.left();
+   layout_.padding_right = padding.right();
+   sizer_->layout(layout_);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 I32 TableRenderer::width_() const {
    return margin.width();
@@ -132,6 +267,16 @@ I32 TableRenderer::height_() const {
    return margin.height();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief True if there are no margins, borders, padding, or box colors, in
+///        which case rendering can skip straight to the sequence.
+bool TableRenderer::is_undecorated_() const {
+   return config_.foreground == LogColor::current &&
+      config_.background == LogColor::current &&
+      margin.width() == seq.width() &&
+      margin.height() == seq.height();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void TableRenderer::freeze_() {
    bool first_freeze = cached_width_ == -1;
@@ -155,20 +300,19 @@ void TableRenderer::freeze_() {
       generate_border_(BoxConfig::right_side);
       generate_border_(BoxConfig::bottom_side);
       generate_border_(BoxConfig::left_side);
+      border.prepare();
    }
+   undecorated_ = is_undecorated_();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void TableRenderer::render_(std::ostream& os) {
-   margin(os);
-}
-
-///////////////////////////////////////////////////////////////////////////////
-void TableRenderer::try_add_border_(BoxConfig::side side) {
-   if (config_.sides[side].margin > 0) {
-      border.enabled(side, true);
-      border.top().emplace_back();
-   }
+/// \brief Restores the margins, padding, and borders that sizing may have
+///        trimmed, so that a new size can be applied.
+void TableRenderer::thaw_() {
+   margin.thaw();
+   base::thaw_();
+   undecorated_ = false;
+   restore_box(*this, config_);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -179,7 +323,7 @@ void TableRenderer::generate_border_(BoxConfig::side side) {
       std::size_t size = 2 + (side == BoxConfig::top_side || side == BoxConfig::bottom_side ?
                               padding.width() : padding.height());
 
-      b = expand_border_pattern(pattern, size);
+      expand_border_pattern(pattern, size, b);
       resolve_border_colors_(side);
    }
 }
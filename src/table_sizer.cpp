@@ -2,16 +2,79 @@
 #include "table_sizer.hpp"
 #include "row_sizer.hpp"
 #include <be/core/alg.hpp>
+#include <chrono>
+#include <numeric>
 
 namespace be::ct {
 namespace detail {
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Splits amount between slots in proportion to their weights, using
+///        largest-remainder rounding so that the shares sum to amount.
+std::vector<I32> distribute_largest_remainder(const std::vector<I32>& weights, I32 amount) {
+   std::vector<I32> shares(weights.size(), 0);
+
+   I64 total_weight = std::accumulate(weights.begin(), weights.end(), (I64)0);
+   if (total_weight <= 0 || amount <= 0) {
+      return shares;
+   }
+
+   std::vector<std::pair<I64, std::size_t>> remainders;
+   remainders.reserve(weights.size());
+
+   I32 distributed = 0;
+   for (std::size_t i = 0, n = weights.size(); i < n; ++i) {
+      I64 weight = weights[i];
+      if (weight <= 0) {
+         continue;
+      }
+      I64 scaled = (I64)amount * weight;
+      I32 share = (I32)(scaled / total_weight);
+      shares[i] = share;
+      distributed += share;
+      remainders.push_back({ scaled % total_weight, i });
+   }
+
+   // fewer leftover units than weighted slots remain, so only the slots with
+   // the largest remainders need to be ordered.
+   std::size_t leftover = (std::size_t)(amount - distributed);
+   leftover = std::min(leftover, remainders.size());
+   auto by_remainder = [](const std::pair<I64, std::size_t>& a, const std::pair<I64, std::size_t>& b) {
+      return a.first > b.first || (a.first == b.first && a.second < b.second);
+   };
+   std::partial_sort(remainders.begin(), remainders.begin() + leftover, remainders.end(), by_remainder);
+   for (std::size_t i = 0; i < leftover; ++i) {
+      ++shares[remainders[i].second];
+   }
+
+   return shares;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The number of lines a cell would occupy if its column had the
+///        given internal width.
+I32 cell_height(const CellRenderer& cell, I32 internal_width) {
+   I32 text_width = std::max(0, internal_width - (cell.padding.left() + cell.padding.right()));
+   I32 text_height = clamp(cell.text.pref_height(text_width), cell.text.min_height(), cell.text.max_height());
+   return text_height + cell.padding.top() + cell.padding.bottom();
+}
+
+} // be::ct::detail::()
 
 ///////////////////////////////////////////////////////////////////////////////
 TableSizer::TableSizer(std::size_t n_rows)
    : left_margin_(0),
      right_margin_(0),
      left_padding_(0),
-     right_padding_(0)
+     right_padding_(0),
+     applied_left_margin_(0),
+     applied_right_margin_(0),
+     applied_left_padding_(0),
+     applied_right_padding_(0),
+     pref_width_percentile_(100),
+     line_count_budget_ms_(0),
+     measure_cells_(true)
 {
    rows_.reserve(n_rows);
 }
@@ -20,15 +83,16 @@ TableSizer::TableSizer(std::size_t n_rows)
 void TableSizer::add(RowRenderer& row) {
    rows_.push_back(&row);
 
-   columns_.reserve(row.cells_.size());
-   for (auto i = columns_.size(), n = row.cells_.size(); i < n; ++i) {
-      columns_.push_back(ColumnSizer(rows_.capacity()));
+   if (columns_.size() < row.cells_.size()) {
+      columns_.resize(row.cells_.size(), ColumnSizer(pref_width_percentile_));
    }
 
-   int column = 0;
-   for (auto& ptr : row.cells_) {
-      columns_[column].add(*ptr);
-      ++column;
+   if (measure_cells_) {
+      int column = 0;
+      for (auto& ptr : row.cells_) {
+         columns_[column].add(*ptr);
+         ++column;
+      }
    }
 
    left_margin_ = max(left_margin_, (U16)(row.margin.left() + (row.border.enabled(BoxConfig::left_side) ? 1 : 0)));
@@ -37,46 +101,155 @@ void TableSizer::add(RowRenderer& row) {
    right_padding_ = max(right_padding_, row.padding.right());
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Uses precomputed column statistics (see Table::column_stats())
+///        instead of measuring the cells of rows added afterwards.
+void TableSizer::column_stats(const std::vector<ColumnStats>& stats) {
+   measure_cells_ = false;
+   if (columns_.size() < stats.size()) {
+      columns_.resize(stats.size(), ColumnSizer(pref_width_percentile_));
+   }
+
+   std::size_t column = 0;
+   for (const ColumnStats& s : stats) {
+      columns_[column].add(s);
+      ++column;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Cells of rows added afterwards will not be measured; only for use
+///        with set_sizes(const LayoutSnapshot&).
+void TableSizer::skip_measurement() {
+   measure_cells_ = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Columns will prefer the width needed by the given percentile of
+///        their cells; must be set before any rows or stats are added.
+void TableSizer::pref_width_percentile(F32 percentile) {
+   pref_width_percentile_ = percentile;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief When columns can't all have their preferred widths, spend up to
+///        budget_ms choosing widths that minimize the total number of lines
+///        rendered, rather than sharing the extra width in proportion to
+///        each column's preferred width.
+void TableSizer::line_count_budget(F32 budget_ms) {
+   line_count_budget_ms_ = budget_ms;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void TableSizer::set_sizes(I32 max_row_width) {
-   I32 max_internal_row_width = max_row_width - (left_margin_ + right_margin_ + left_padding_ + right_padding_);
+   applied_left_margin_ = left_margin_;
+   applied_right_margin_ = right_margin_;
+   applied_left_padding_ = left_padding_;
+   applied_right_padding_ = right_padding_;
+
+   I32 max_internal_row_width = max_row_width - (applied_left_margin_ + applied_right_margin_ + applied_left_padding_ + applied_right_padding_);
    while (max_internal_row_width < 0) {
-      if (left_margin_ <= 1 && right_margin_ <= 1 && (left_padding_ > 0 || right_padding_ > 0)) {
-         if (right_padding_ > left_padding_) {
-            --right_padding_;
+      if (applied_left_margin_ <= 1 && applied_right_margin_ <= 1 && (applied_left_padding_ > 0 || applied_right_padding_ > 0)) {
+         if (applied_right_padding_ > applied_left_padding_) {
+            --applied_right_padding_;
          } else {
-            --left_padding_;
+            --applied_left_padding_;
          }
       } else {
-         if (right_margin_ > left_margin_) {
-            --right_margin_;
-         } else if (left_margin_ > 0) {
-            --left_margin_;
+         if (applied_right_margin_ > applied_left_margin_) {
+            --applied_right_margin_;
+         } else if (applied_left_margin_ > 0) {
+            --applied_left_margin_;
          }
       }
       ++max_internal_row_width;
    }
 
+   set_column_widths_(max_internal_row_width);
+   apply_(nullptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Applies a layout previously recorded by layout() instead of
+///        calculating one.  Cells are not measured.
+void TableSizer::set_sizes(const LayoutSnapshot& layout) {
+   std::size_t n_columns = 0;
    for (RowRenderer* row : rows_) {
-      row->padding.left(left_padding_);
-      row->padding.right(right_padding_);
+      n_columns = std::max(n_columns, row->cells_.size());
+   }
+
+   if (layout.columns.size() != n_columns ||
+       (!layout.rows.empty() && layout.rows.size() != rows_.size())) {
+      throw std::invalid_argument("Layout snapshot does not match table shape!");
+   }
+
+   applied_left_margin_ = layout.row_left_external;
+   applied_right_margin_ = layout.row_right_external;
+   applied_left_padding_ = layout.row_padding_left;
+   applied_right_padding_ = layout.row_padding_right;
+
+   columns_.resize(n_columns);
+   std::size_t column = 0;
+   for (const ColumnLayout& c : layout.columns) {
+      columns_[column].set_widths(c);
+      ++column;
+   }
+
+   apply_(layout.rows.empty() ? nullptr : &layout.rows);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Records the row and column sizes chosen by the last call to
+///        set_sizes().
+void TableSizer::layout(LayoutSnapshot& layout) const {
+   layout.row_left_external = applied_left_margin_;
+   layout.row_right_external = applied_right_margin_;
+   layout.row_padding_left = applied_left_padding_;
+   layout.row_padding_right = applied_right_padding_;
+
+   layout.columns.clear();
+   layout.columns.reserve(columns_.size());
+   for (const ColumnSizer& col : columns_) {
+      layout.columns.push_back(col.layout());
+   }
 
-      if (left_margin_ == 0) {
+   layout.rows = row_layouts_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Returns the preferred internal width of each column, clamped to
+///        its min and max widths.
+std::vector<I32> TableSizer::pref_internal_widths() const {
+   std::vector<I32> widths;
+   widths.reserve(columns_.size());
+   for (const ColumnSizer& col : columns_) {
+      widths.push_back(clamp(col.pref_internal_width(), col.min_internal_width(), col.max_internal_width()));
+   }
+   return widths;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TableSizer::apply_(const std::vector<RowLayout>* row_layouts) {
+   for (RowRenderer* row : rows_) {
+      row->padding.left(applied_left_padding_);
+      row->padding.right(applied_right_padding_);
+
+      if (applied_left_margin_ == 0) {
          row->margin.left(0);
          row->border.enabled(BoxConfig::left_side, false);
       } else {
-         U16 new_margin = left_margin_;
+         U16 new_margin = applied_left_margin_;
          if (row->border.enabled(BoxConfig::left_side)) {
             --new_margin;
          }
          row->margin.left(new_margin);
       }
 
-      if (right_margin_ == 0) {
+      if (applied_right_margin_ == 0) {
          row->margin.right(0);
          row->border.enabled(BoxConfig::right_side, false);
       } else {
-         U16 new_margin = right_margin_;
+         U16 new_margin = applied_right_margin_;
          if (row->border.enabled(BoxConfig::right_side)) {
             --new_margin;
          }
@@ -84,8 +257,29 @@ void TableSizer::set_sizes(I32 max_row_width) {
       }
    }
 
-   // figure out how to split remaining max_row_width between columns
+   for (RowRenderer* row : rows_) {
+      std::size_t column = 0;
+      for (auto& ptr : row->cells_) {
+         columns_[column].apply(*ptr);
+         ++column;
+      }
+   }
+
+   // Calculate heights
+   row_layouts_.clear();
+   row_layouts_.reserve(rows_.size());
+   std::size_t index = 0;
+   for (RowRenderer* row : rows_) {
+      RowSizer sizer = row_layouts ? RowSizer(*row, (*row_layouts)[index]) : RowSizer(*row);
+      sizer.set_heights();
+      row_layouts_.push_back(sizer.layout());
+      ++index;
+   }
+}
 
+///////////////////////////////////////////////////////////////////////////////
+void TableSizer::set_column_widths_(I32 max_internal_row_width) {
+   // figure out how to split remaining max_row_width between columns
    I32 total_column_external = 0;
    I32 total_column_min = 0;
    I32 total_column_pref = 0;
@@ -106,50 +300,22 @@ void TableSizer::set_sizes(I32 max_row_width) {
    } else if (total_column_min + total_column_external <= max_internal_row_width) {
       // min width is ok; try to expand as much as possible
       I32 remaining = max_internal_row_width - (total_column_min + total_column_external);
-      I32 total_wanted = 0;
-      std::vector<std::pair<I32, I32>> extras;
-      extras.reserve(columns_.size());
+      std::vector<I32> wanted;
+      wanted.reserve(columns_.size());
       for (ColumnSizer& col : columns_) {
-         I32 wanted = std::max(0, col.pref_internal_width() - col.min_internal_width());
-         extras.push_back({ 0, wanted });
-         total_wanted += wanted;
+         wanted.push_back(std::max(0, col.pref_internal_width() - col.min_internal_width()));
       }
 
-      I32 remaining_used = 0;
-      for (auto& p : extras) {
-         if (p.second <= 0) {
-            continue;
-         }
-         I32 used = (I32)floor(remaining * ((F32)p.second / (F32)total_wanted));
-         p.first = used;
-         remaining_used += used;
-      }
-
-      while (remaining_used < remaining) {
-         I32* selected_extra = nullptr;
-         F32 selected_ratio = 1337; // arbitrary large initializer
-         for (auto& p : extras) {
-            if (p.second <= 0) {
-               continue;
-            }
-            F32 ratio = (F32)p.first / (F32)p.second;
-            if (ratio < selected_ratio) {
-               selected_ratio = ratio;
-               selected_extra = &p.first;
-            }
-         }
-         if (selected_extra) {
-            ++*selected_extra;
-         }
-         ++remaining_used;
+      std::vector<I32> extras = distribute_largest_remainder(wanted, remaining);
+      if (line_count_budget_ms_ > 0) {
+         minimize_line_count_(remaining, extras);
       }
 
       std::size_t index = 0;
       for (ColumnSizer& col : columns_) {
-         col.set_widths(col.min_internal_width() + col.external_width() + extras[index].first);
+         col.set_widths(col.min_internal_width() + col.external_width() + extras[index]);
          ++index;
       }
-
    } else {
       // not enough room for min width; use min width for first columns until we run out, then use 0.
       I32 remaining = max_internal_row_width;
@@ -164,11 +330,194 @@ void TableSizer::set_sizes(I32 max_row_width) {
          }
       }
    }
+}
 
-   // Calculate heights
-   for (RowRenderer* row : rows_) {
-      RowSizer sizer(*row);
-      sizer.set_heights();
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Greedily hands out the remaining width to whichever column saves
+///        the most lines per unit of width.  extras is replaced only if the
+///        search finishes within the time budget and wraps to fewer lines
+///        than the proportional distribution already in extras.
+void TableSizer::minimize_line_count_(I32 remaining, std::vector<I32>& extras) const {
+   using clock = std::chrono::steady_clock;
+   const auto deadline = clock::now() + std::chrono::duration_cast<clock::duration>(
+      std::chrono::duration<F64, std::milli>(line_count_budget_ms_));
+   auto expired = [&]() { return clock::now() > deadline; };
+
+   const std::size_t n_rows = rows_.size();
+   const std::size_t n_columns = columns_.size();
+
+   std::vector<I32> min_widths;
+   std::vector<I32> max_widths;
+   min_widths.reserve(n_columns);
+   max_widths.reserve(n_columns);
+   for (const ColumnSizer& col : columns_) {
+      min_widths.push_back(col.min_internal_width());
+      max_widths.push_back(std::max(col.min_internal_width(), col.pref_internal_width()));
+   }
+
+   // cell heights for each column, indexed by width - min width; filled in
+   // lazily since most widths are never considered.
+   std::vector<std::vector<std::vector<I32>>> heights(n_columns);
+   for (std::size_t c = 0; c < n_columns; ++c) {
+      heights[c].resize((std::size_t)(max_widths[c] - min_widths[c] + 1));
+   }
+   auto column_heights = [&](std::size_t column, I32 width) -> const std::vector<I32>* {
+      auto& h = heights[column][(std::size_t)(width - min_widths[column])];
+      if (h.empty() && n_rows > 0) {
+         if (expired()) {
+            return nullptr;
+         }
+         h.resize(n_rows, 0);
+         for (std::size_t r = 0; r < n_rows; ++r) {
+            const auto& cells = rows_[r]->cells_;
+            if (column < cells.size()) {
+               h[r] = cell_height(*cells[column], width);
+            }
+         }
+      }
+      return &h;
+   };
+
+   auto line_count = [&](const std::vector<I32>& widths, I64& lines) {
+      std::vector<I32> row_heights(n_rows, 0);
+      for (std::size_t c = 0; c < n_columns; ++c) {
+         const std::vector<I32>* h = column_heights(c, widths[c]);
+         if (!h) {
+            return false;
+         }
+         for (std::size_t r = 0; r < n_rows; ++r) {
+            row_heights[r] = std::max(row_heights[r], (*h)[r]);
+         }
+      }
+      lines = std::accumulate(row_heights.begin(), row_heights.end(), (I64)0);
+      return true;
+   };
+
+   // A column with no width hides its text entirely rather than wrapping
+   // it, so start every column with at least one character.
+   std::vector<I32> widths = min_widths;
+   for (std::size_t c = 0; c < n_columns; ++c) {
+      if (widths[c] == 0 && max_widths[c] > 0) {
+         if (remaining == 0) {
+            return;
+         }
+         widths[c] = 1;
+         --remaining;
+      }
+   }
+
+   // the tallest cell in each row, how many cells share that height, and the
+   // height of the next tallest cell, so the effect of changing one column's
+   // width on a row's height can be found without visiting the other columns.
+   std::vector<I32> top(n_rows);
+   std::vector<I32> top_count(n_rows);
+   std::vector<I32> second(n_rows);
+   auto update_rows = [&]() {
+      std::fill(top.begin(), top.end(), 0);
+      std::fill(top_count.begin(), top_count.end(), 0);
+      std::fill(second.begin(), second.end(), 0);
+      for (std::size_t c = 0; c < n_columns; ++c) {
+         const std::vector<I32>* h = column_heights(c, widths[c]);
+         if (!h || expired()) {
+            return false;
+         }
+         for (std::size_t r = 0; r < n_rows; ++r) {
+            I32 v = (*h)[r];
+            if (v > top[r]) {
+               second[r] = top[r];
+               top[r] = v;
+               top_count[r] = 1;
+            } else if (v == top[r]) {
+               ++top_count[r];
+            } else if (v > second[r]) {
+               second[r] = v;
+            }
+         }
+      }
+      return true;
+   };
+
+   if (!update_rows()) {
+      return;
+   }
+
+   // heights are often already cached, so column_heights() alone won't
+   // notice the deadline passing; check it for each step considered too.
+   while (remaining > 0) {
+      if (expired()) {
+         return;
+      }
+
+      std::size_t best_column = n_columns;
+      I64 best_gain = 0;
+      I32 best_step = 0;
+
+      for (std::size_t c = 0; c < n_columns; ++c) {
+         const std::vector<I32>* current = column_heights(c, widths[c]);
+         if (!current) {
+            return;
+         }
+         I32 max_step = std::min(remaining, max_widths[c] - widths[c]);
+         for (I32 step = 1; step <= max_step; ++step) {
+            const std::vector<I32>* h = column_heights(c, widths[c] + step);
+            if (!h || expired()) {
+               return;
+            }
+
+            I64 gain = 0;
+            for (std::size_t r = 0; r < n_rows; ++r) {
+               I32 old_height = (*current)[r];
+               I32 others = (old_height == top[r] && top_count[r] == 1) ? second[r] : top[r];
+               gain += top[r] - std::max(others, (*h)[r]);
+            }
+
+            if (gain > 0) {
+               // compare lines saved per unit of width, gain / step
+               if (best_column == n_columns || gain * best_step > best_gain * step) {
+                  best_column = c;
+                  best_gain = gain;
+                  best_step = step;
+               }
+               break;
+            }
+         }
+      }
+
+      if (best_column == n_columns) {
+         break;
+      }
+
+      widths[best_column] += best_step;
+      remaining -= best_step;
+      if (!update_rows()) {
+         return;
+      }
+   }
+
+   if (remaining > 0) {
+      // no more lines can be saved; share what's left as usual.
+      std::vector<I32> wanted;
+      wanted.reserve(n_columns);
+      for (std::size_t c = 0; c < n_columns; ++c) {
+         wanted.push_back(max_widths[c] - widths[c]);
+      }
+      std::vector<I32> leftover = distribute_largest_remainder(wanted, remaining);
+      for (std::size_t c = 0; c < n_columns; ++c) {
+         widths[c] += leftover[c];
+      }
+   }
+
+   std::vector<I32> proportional_widths = min_widths;
+   for (std::size_t c = 0; c < n_columns; ++c) {
+      proportional_widths[c] += extras[c];
+   }
+
+   I64 lines = 0;
+   I64 proportional_lines = 0;
+   if (line_count(widths, lines) && line_count(proportional_widths, proportional_lines) && lines < proportional_lines) {
+      for (std::size_t c = 0; c < n_columns; ++c) {
+         extras[c] = widths[c] - min_widths[c];
+      }
    }
 }
 
@@ -1,5 +1,6 @@
 #include "pch.hpp"
 #include "text_renderer.hpp"
+#include "line_program.hpp"
 #include <numeric>
 
 namespace be::ct {
@@ -8,11 +9,15 @@ namespace detail {
 ///////////////////////////////////////////////////////////////////////////////
 TextRenderer::TextRenderer(const Cell& cell)
    : cell_(cell),
-     pref_w_(calc_pref_width_()),
+     wrapped_(true),
+     output_cache_(nullptr),
+     pref_w_(-1),
      w_(0),
      h_(0),
      align_(cell.config().box.align)
-{ }
+{
+   cell.clean();
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 I32 TextRenderer::min_width() const {
@@ -42,6 +47,9 @@ I32 TextRenderer::max_height() const {
 I32 TextRenderer::pref_width() const {
    I32 val = cell_.config().pref_width;
    if (val < 0) {
+      if (pref_w_ < 0) {
+         pref_w_ = calc_pref_width_();
+      }
       val = pref_w_;
    }
    return val;
@@ -53,7 +61,7 @@ I32 TextRenderer::pref_height(I32 width) const {
    if (width == 0) {
       return 0;
    } else if (width == w_) {
-      h = lines_.size();
+      h = lines_().size();
    } else {
       h = calc_data_(width).size();
    }
@@ -62,18 +70,27 @@ I32 TextRenderer::pref_height(I32 width) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 void TextRenderer::width(I32 width) {
-   w_ = width;
-   lines_ = calc_data_(w_);
+   if (width != w_) {
+      w_ = width;
+      wrapped_ = false;
+      program_ptr_.reset();
+      invalidate();
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 void TextRenderer::height(I32 height) {
    h_ = height;
+   program_ptr_.reset();
+   invalidate();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 void TextRenderer::align(U8 align) {
-   align_ = align;
+   if (align != align_) {
+      align_ = align;
+      program_ptr_.reset();
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -81,14 +98,22 @@ U8 TextRenderer::align() const {
    return align_;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief When a cache is provided, each distinct combination of cell
+///        content, size, and alignment is only wrapped and formatted once;
+///        later renderers of an identical cell replay the cached lines.
+///        Only affects rendering to a std::ostream.
+void TextRenderer::output_cache(CellOutputCache* cache) {
+   output_cache_ = cache;
+   program_ptr_.reset();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 I32 TextRenderer::calc_pref_width_() const {
    std::size_t pref_width = 0;
    std::size_t current_width = 0;
 
-   cell_.clean();
-
-   for (Cell::datum d : cell_.data_) {
+   for (const Cell::datum& d : cell_.data_) {
       current_width += d.text.size();
       if (current_width > pref_width) {
          pref_width = current_width;
@@ -171,21 +196,68 @@ void TextRenderer::add_datum_(vec_type& data, I32 width, std::size_t& remaining,
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void TextRenderer::render_(std::ostream& os) {
-   I32 index = line_;
+/// \brief Wrapping is deferred until the lines are needed, since a cell whose
+///        output is found in the cache never needs to be wrapped at all.
+const TextRenderer::vec_type& TextRenderer::lines_() const {
+   if (!wrapped_) {
+      wrapped_lines_ = calc_data_(w_);
+      wrapped_ = true;
+   }
+   return wrapped_lines_;
+}
 
-   if (lines_.size() < h_) {
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Finds or generates the LineProgram containing every line of this
+///        cell at its current size.
+const CellOutputCache::program_ptr& TextRenderer::program_() {
+   if (!program_ptr_) {
+      CellOutputCache::key k { cell_.hash(), w_, h_, align_ };
+      program_ptr_ = output_cache_->find(k);
+      if (!program_ptr_) {
+         auto program = std::make_shared<LineProgram>();
+         LineProgramWriter writer(*program);
+         for (I32 line = 0; line < h_; ++line) {
+            writer.begin_line(w_);
+            render_at_(writer, line);
+         }
+         program_ptr_ = program;
+         output_cache_->insert(k, program_ptr_);
+      }
+   }
+   return program_ptr_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Stream>
+void TextRenderer::render_(Stream& os) {
+   if constexpr (std::is_same_v<Stream, std::ostream>) {
+      if (output_cache_) {
+         program_()->render_line(os, line_);
+         return;
+      }
+   }
+
+   render_at_(os, line_);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Stream>
+void TextRenderer::render_at_(Stream& os, I32 line) {
+   const vec_type& lines = lines_();
+   I32 index = line;
+
+   if (lines.size() < h_) {
       // determine where extra padding for vertical alignment should go
       U8 valign = align_ & (BoxConfig::align_top | BoxConfig::align_bottom | BoxConfig::align_middle);
 
       if (valign == BoxConfig::align_middle) {
-         index -= (h_ - clamp_(lines_.size())) >> 1;
+         index -= (h_ - clamp_(lines.size())) >> 1;
       } else if (valign == BoxConfig::align_bottom) {
-         index -= h_ - clamp_(lines_.size());
+         index -= h_ - clamp_(lines.size());
       }
    }
 
-   if (index < 0 || index >= lines_.size()) {
+   if (index < 0 || index >= lines.size()) {
       render_blank_(os);
    } else {
       render_line_(os, index);
@@ -193,8 +265,9 @@ void TextRenderer::render_(std::ostream& os) {
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void TextRenderer::render_line_(std::ostream& os, I32 index) {
-   line_type& data = lines_[index];
+template <typename Stream>
+void TextRenderer::render_line_(Stream& os, I32 index) {
+   const line_type& data = lines_()[index];
 
    std::size_t data_length = std::accumulate(data.begin(), data.end(), (std::size_t)0,
       [](std::size_t v, const datum& d) {
@@ -222,7 +295,7 @@ void TextRenderer::render_line_(std::ostream& os, I32 index) {
       color_ = initial;
    }
 
-   for (datum& d : data) {
+   for (const datum& d : data) {
       auto color = setcolor(d.foreground, d.background);
       if (color.fg == LogColor::initial) {
          color.fg = initial.fg;
@@ -249,5 +322,8 @@ void TextRenderer::render_line_(std::ostream& os, I32 index) {
    }
 }
 
+template void TextRenderer::render_<std::ostream>(std::ostream&);
+template void TextRenderer::render_<LineProgramWriter>(LineProgramWriter&);
+
 } // be::ct::detail
 } // be::ct
@@ -0,0 +1,115 @@
+#include "pch.hpp"
+#include "width_sketch.hpp"
+#include <cmath>
+
+namespace be::ct {
+namespace {
+
+constexpr const I32 exact_limit = 32;
+constexpr const I32 exact_limit_log2 = 5;
+constexpr const I32 sub_bucket_bits = 3;
+constexpr const I32 sub_buckets = 1 << sub_bucket_bits;
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t bucket_index(I32 width) {
+   if (width < exact_limit) {
+      return (std::size_t)std::max(width, 0);
+   }
+
+   I32 e = exact_limit_log2;
+   while ((width >> (e + 1)) != 0) {
+      ++e;
+   }
+
+   I32 sub = (width >> (e - sub_bucket_bits)) & (sub_buckets - 1);
+   return (std::size_t)(exact_limit + (e - exact_limit_log2) * sub_buckets + sub);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+I32 bucket_max(std::size_t index) {
+   if (index < (std::size_t)exact_limit) {
+      return (I32)index;
+   }
+
+   I32 e = exact_limit_log2 + (I32)(index - exact_limit) / sub_buckets;
+   I32 sub = (I32)(index - exact_limit) % sub_buckets;
+   I64 base = (I64)(sub_buckets + sub) << (e - sub_bucket_bits);
+   I64 last = base + ((I64)1 << (e - sub_bucket_bits)) - 1;
+   return (I32)std::min(last, (I64)std::numeric_limits<I32>::max());
+}
+
+} // be::ct::()
+
+///////////////////////////////////////////////////////////////////////////////
+WidthSketch::WidthSketch()
+   : size_(0),
+     max_(0)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+void WidthSketch::add(I32 width) {
+   std::size_t index = bucket_index(width);
+   if (index >= counts_.size()) {
+      counts_.resize(index + 1, 0);
+   }
+   ++counts_[index];
+   ++size_;
+   max_ = std::max(max_, width);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void WidthSketch::add(const WidthSketch& other) {
+   if (other.counts_.size() > counts_.size()) {
+      counts_.resize(other.counts_.size(), 0);
+   }
+   for (std::size_t i = 0, n = other.counts_.size(); i < n; ++i) {
+      counts_[i] += other.counts_[i];
+   }
+   size_ += other.size_;
+   max_ = std::max(max_, other.max_);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool WidthSketch::empty() const {
+   return size_ == 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+U32 WidthSketch::size() const {
+   return size_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+I32 WidthSketch::max() const {
+   return max_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Returns an upper bound on the q-quantile (0 <= q <= 1) of the widths
+///        added so far, or 0 if the sketch is empty.
+I32 WidthSketch::quantile(F32 q) const {
+   if (size_ == 0) {
+      return 0;
+   }
+
+   if (q >= 1) {
+      return max_;
+   }
+
+   // nearest-rank; the small bias keeps q * size_ from rounding up past an
+   // exact rank due to F32 representation error (e.g. 0.99f * 100).
+   U64 rank = (U64)std::ceil((F64)std::max(q, 0.f) * size_ - 1e-4);
+   rank = std::max(rank, (U64)1);
+
+   U64 seen = 0;
+   for (std::size_t i = 0, n = counts_.size(); i < n; ++i) {
+      seen += counts_[i];
+      if (seen >= rank) {
+         return std::min(bucket_max(i), max_);
+      }
+   }
+
+   return max_;
+}
+
+} // be::ct
@@ -0,0 +1,130 @@
+#ifdef BE_TEST
+
+#include "table_sizer.hpp"
+#include "table_renderer.hpp"
+#include <catch/catch.hpp>
+#include <chrono>
+
+#define BE_CATCH_TAGS "[ct][ct:TableSizer][.][perf]"
+
+using namespace be;
+using namespace be::ct;
+using namespace be::ct::detail;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+Row make_row(std::size_t columns) {
+   Row row;
+   row.reserve(columns);
+   for (std::size_t i = 0; i < columns; ++i) {
+      row << cell << "column " << i << " with some wrappable text";
+   }
+   return row;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename F>
+F64 time_ms(F func) {
+   auto start = std::chrono::steady_clock::now();
+   func();
+   auto end = std::chrono::steady_clock::now();
+   return std::chrono::duration<F64, std::milli>(end - start).count();
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("TableSizer with 10k columns", BE_CATCH_TAGS) {
+   const std::size_t columns = 10000;
+   const std::size_t rows = 16;
+   Row row = make_row(columns);
+   RowRenderer r(row);
+
+   // wide enough for min widths, too narrow for preferred widths, so the
+   // leftover width must be distributed proportionally, with a remainder
+   // left over after the proportional shares are rounded down.
+   const I32 width = (I32)(columns * 12 + columns / 2 - 1);
+
+   F64 ms = time_ms([&]() {
+      TableSizer sizer(rows);
+      for (std::size_t i = 0; i < rows; ++i) {
+         sizer.add(r);
+      }
+      sizer.set_sizes(width);
+   });
+
+   WARN("10k columns x " << rows << " rows: " << ms << " ms");
+   REQUIRE(r.width() == width);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("TableSizer with 1M cells in distinct rows", BE_CATCH_TAGS) {
+   const std::size_t columns = 4;
+   const std::size_t rows = 250000;
+
+   // every row has its own content and renderer, so each one is measured,
+   // wrapped, and sized separately; renderers are too large for 1M rows of
+   // them to fit comfortably in memory, so this uses 1M cells instead.
+   std::vector<Row> data;
+   data.reserve(rows);
+   for (std::size_t i = 0; i < rows; ++i) {
+      Row row;
+      row << cell << "row " << i
+          << cell << S(i % 37, 'x') << " wrappable " << i * 7919
+          << cell << (i % 5 == 0 ? "some longer text that needs to wrap" : "short")
+          << cell << i % 1000;
+      data.push_back(std::move(row));
+   }
+
+   std::vector<std::unique_ptr<RowRenderer>> renderers;
+   renderers.reserve(rows);
+   for (const Row& row : data) {
+      renderers.push_back(std::make_unique<RowRenderer>(row));
+   }
+
+   const I32 width = 61;
+
+   F64 ms = time_ms([&]() {
+      TableSizer sizer(rows);
+      for (auto& r : renderers) {
+         sizer.add(*r);
+      }
+      sizer.set_sizes(width);
+   });
+
+   WARN(rows << " distinct rows x " << columns << " columns: " << ms << " ms");
+   bool all_fit = true;
+   for (auto& r : renderers) {
+      all_fit = all_fit && r->width() == width;
+   }
+   REQUIRE(all_fit);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("TableRenderer width queries while sizing", BE_CATCH_TAGS) {
+   const std::size_t rows = 100000;
+   Table table;
+   for (std::size_t i = 0; i < rows; ++i) {
+      table << row << cell << "row " << i << cell << "some wrappable text" << cell << i;
+   }
+
+   TableRenderer r(table);
+   r.auto_size(80);
+   const I32 width = r.width();
+
+   // dimensions are memoized until a setter invalidates them, so repeated
+   // queries must not walk every row and cell.
+   bool same = true;
+   F64 ms = time_ms([&]() {
+      for (int i = 0; i < 1000000; ++i) {
+         same = same && r.width() == width && r.height() > 0;
+      }
+   });
+
+   WARN("1M width queries on " << rows << " rows: " << ms << " ms");
+   REQUIRE(same);
+   REQUIRE(width <= 80);
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifdef BE_TEST
+
+#include "background_renderer.hpp"
+#include <catch/catch.hpp>
+#include <sstream>
+
+#define BE_CATCH_TAGS "[ct][ct:BackgroundRenderer]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+Table make_table(int value) {
+   TableConfig config;
+   set_border(config.box, BorderConfig { 1, 1, LogColor::current, "-" }, BorderConfig { 1, 1, LogColor::current, "|" });
+   Table t(config);
+   t << header << cell << "Name" << cell << "Value";
+   t << row << cell << "requests" << cell << setcolor(LogColor::green) << value;
+   return t;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+S expected_frame(const Table& table, I32 width) {
+   S out;
+   LineEncoder().encode(compile(table, width), out);
+   return out;
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("BackgroundRenderer renders the latest table", BE_CATCH_TAGS) {
+   BackgroundRenderer renderer(40);
+   S frame;
+
+   REQUIRE_FALSE(renderer.take(frame));
+
+   renderer.submit(make_table(1));
+   renderer.wait();
+   REQUIRE(renderer.take(frame));
+   REQUIRE(frame == expected_frame(make_table(1), 40));
+   REQUIRE_FALSE(renderer.take(frame));
+
+   for (int i = 2; i <= 10; ++i) {
+      renderer.submit(make_table(i));
+   }
+   renderer.wait();
+   REQUIRE(renderer.frames() + renderer.coalesced() == 10);
+
+   std::ostringstream os;
+   REQUIRE(renderer.write(os));
+   REQUIRE(os.str() == expected_frame(make_table(10), 40));
+   REQUIRE_FALSE(renderer.write(os));
+}
+
+#endif
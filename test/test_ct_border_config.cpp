@@ -1,6 +1,6 @@
 #ifdef BE_TEST
 
-#include "border_config.hpp"
+#include "compiled_border_pattern.hpp"
 #include <catch/catch.hpp>
 
 #define BE_CATCH_TAGS "[ct][ct:BorderConfig]"
@@ -9,6 +9,14 @@ using namespace be;
 using namespace be::ct;
 using namespace std::rel_ops;
 
+// checks both the runtime parser and CompiledBorderPattern
+#define REQUIRE_EXPANDS(expected, pattern, width) \
+   do { \
+      constexpr CompiledBorderPattern compiled_pattern(pattern); \
+      REQUIRE(expected == expand_border_pattern(pattern, width)); \
+      REQUIRE(expected == expand_border_pattern(compiled_pattern, width)); \
+   } while (false)
+
 namespace be {
 namespace ct {
 
@@ -172,108 +180,122 @@ std::vector<BorderChar> colored(const S str, S fg = S(), S bg = S()) {
 ///////////////////////////////////////////////////////////////////////////////
 TEST_CASE("expand_border_pattern()", BE_CATCH_TAGS) {
    SECTION("Single implicit expandable group") {
-      REQUIRE(simple("-") == expand_border_pattern("-", 1));
-      REQUIRE(simple("-") == expand_border_pattern("---", 1));
-      REQUIRE(simple("-") == expand_border_pattern("-============", 1));
-      REQUIRE(simple("-----") == expand_border_pattern("-", 5));
-      REQUIRE(simple("-=-=-") == expand_border_pattern("-=", 5));
-      REQUIRE(simple("-=-=-=-=-=-=-=-=") == expand_border_pattern("-=", 16));
-      REQUIRE(simple("--==-") == expand_border_pattern("--==", 5));
-      REQUIRE(simple("-====") == expand_border_pattern("-=============", 5));
+      REQUIRE_EXPANDS(simple("-"), "-", 1);
+      REQUIRE_EXPANDS(simple("-"), "---", 1);
+      REQUIRE_EXPANDS(simple("-"), "-============", 1);
+      REQUIRE_EXPANDS(simple("-----"), "-", 5);
+      REQUIRE_EXPANDS(simple("-=-=-"), "-=", 5);
+      REQUIRE_EXPANDS(simple("-=-=-=-=-=-=-=-="), "-=", 16);
+      REQUIRE_EXPANDS(simple("--==-"), "--==", 5);
+      REQUIRE_EXPANDS(simple("-===="), "-=============", 5);
    }
 
    SECTION("Explicit expandable groups") {
-      REQUIRE(simple("||||----") == expand_border_pattern("(|)(-)", 8));
-      REQUIRE(simple("||||----") == expand_border_pattern("(|)-", 8));
-      REQUIRE(simple("||||----") == expand_border_pattern("|(-)", 8));
-      REQUIRE(simple("||||---") == expand_border_pattern("(|)(-)", 7));
-      REQUIRE(simple("--==--=-=") == expand_border_pattern("(-)=(-)=(-)=", 9));
-      REQUIRE(simple("----====---===---===") == expand_border_pattern("(-)=(-)=(-)=", 20));
+      REQUIRE_EXPANDS(simple("||||----"), "(|)(-)", 8);
+      REQUIRE_EXPANDS(simple("||||----"), "(|)-", 8);
+      REQUIRE_EXPANDS(simple("||||----"), "|(-)", 8);
+      REQUIRE_EXPANDS(simple("||||---"), "(|)(-)", 7);
+      REQUIRE_EXPANDS(simple("--==--=-="), "(-)=(-)=(-)=", 9);
+      REQUIRE_EXPANDS(simple("----====---===---==="), "(-)=(-)=(-)=", 20);
 
-      REQUIRE(simple("| | |./*./") == expand_border_pattern("(| )(./*)", 10));
-      REQUIRE(simple("| | |./*./") == expand_border_pattern("(| )./*", 10));
-      REQUIRE(simple("| | | | | ./*./*./*.") == expand_border_pattern("| (./*)", 20));
+      REQUIRE_EXPANDS(simple("| | |./*./"), "(| )(./*)", 10);
+      REQUIRE_EXPANDS(simple("| | |./*./"), "(| )./*", 10);
+      REQUIRE_EXPANDS(simple("| | | | | ./*./*./*."), "| (./*)", 20);
 
-      REQUIRE(simple("| |------") == expand_border_pattern("| | | |(-)-", 9));
-      REQUIRE(simple("| | | ||----------------") == expand_border_pattern("| | | |(-)-", 24));
+      REQUIRE_EXPANDS(simple("| |------"), "| | | |(-)-", 9);
+      REQUIRE_EXPANDS(simple("| | | ||----------------"), "| | | |(-)-", 24);
 
-      REQUIRE(simple("-----=-=-=-----") == expand_border_pattern("-(=-)-", 15));
+      REQUIRE_EXPANDS(simple("-----=-=-=-----"), "-(=-)-", 15);
    }
 
    SECTION("Non-expandable groups") {
-      REQUIRE(simple("+---") == expand_border_pattern("[+]-", 4));
-      REQUIRE(simple("---+") == expand_border_pattern("-[+]", 4));
-      REQUIRE(simple("+-------") == expand_border_pattern("[+]-", 8));
-      REQUIRE(simple("-------+") == expand_border_pattern("-[+]", 8));
-      REQUIRE(simple("+------+") == expand_border_pattern("[+]-[+]", 8));
-      REQUIRE(simple("+------+") == expand_border_pattern("[+](-)[+]", 8));
-      REQUIRE(simple("|>----<|") == expand_border_pattern("[|>]-[<|]", 8));
-      REQUIRE(simple("|><") == expand_border_pattern("[|>]-[<|]", 3));
-      REQUIRE(simple("---+---+") == expand_border_pattern("-[+]-[+]", 8));
-      REQUIRE(simple("=====---=====") == expand_border_pattern("=[---]=", 13));
-      REQUIRE(simple("------- TITLE ------") == expand_border_pattern("(-)[ TITLE ](-)", 20));
-      REQUIRE(simple(" - TITLE -=-=-=-=-= ") == expand_border_pattern("[ - TITLE ](-=)[ ]", 20));
-      REQUIRE(simple(" - TITLE -=--=--=-- ") == expand_border_pattern("[ - TITLE ](-=-)[ ]", 20));
+      REQUIRE_EXPANDS(simple("+---"), "[+]-", 4);
+      REQUIRE_EXPANDS(simple("---+"), "-[+]", 4);
+      REQUIRE_EXPANDS(simple("+-------"), "[+]-", 8);
+      REQUIRE_EXPANDS(simple("-------+"), "-[+]", 8);
+      REQUIRE_EXPANDS(simple("+------+"), "[+]-[+]", 8);
+      REQUIRE_EXPANDS(simple("+------+"), "[+](-)[+]", 8);
+      REQUIRE_EXPANDS(simple("|>----<|"), "[|>]-[<|]", 8);
+      REQUIRE_EXPANDS(simple("|><"), "[|>]-[<|]", 3);
+      REQUIRE_EXPANDS(simple("---+---+"), "-[+]-[+]", 8);
+      REQUIRE_EXPANDS(simple("=====---====="), "=[---]=", 13);
+      REQUIRE_EXPANDS(simple("------- TITLE ------"), "(-)[ TITLE ](-)", 20);
+      REQUIRE_EXPANDS(simple(" - TITLE -=-=-=-=-= "), "[ - TITLE ](-=)[ ]", 20);
+      REQUIRE_EXPANDS(simple(" - TITLE -=--=--=-- "), "[ - TITLE ](-=-)[ ]", 20);
    }
 
    SECTION("Escapes") {
-      REQUIRE(simple("(--------------") == expand_border_pattern("[$(]-", 15));
-      REQUIRE(simple("(--------------") == expand_border_pattern("[$28]-", 15));
-      REQUIRE(simple("$-------------$") == expand_border_pattern("[$24]-[$$]", 15));
-      REQUIRE(simple("[-------------]") == expand_border_pattern("[$[]-[$]]", 15));
-      REQUIRE(simple("-------------[]") == expand_border_pattern("-[[]]", 15));
-      REQUIRE(simple("----<[asdf]>---") == expand_border_pattern("-[<[asdf]>]-", 15));
-      REQUIRE(simple("[][][][][][][][") == expand_border_pattern("([])", 15));
-      REQUIRE(simple("[()][()][()][()") == expand_border_pattern("([()])", 15));
-      REQUIRE(simple("()-------------") == expand_border_pattern("[()]-", 15));
-      REQUIRE(simple("([])-----------") == expand_border_pattern("[([])]-", 15));
-      REQUIRE(simple("(()())()-------") == expand_border_pattern("[(()())()]-", 15));
+      REQUIRE_EXPANDS(simple("(--------------"), "[$(]-", 15);
+      REQUIRE_EXPANDS(simple("(--------------"), "[$28]-", 15);
+      REQUIRE_EXPANDS(simple("$-------------$"), "[$24]-[$$]", 15);
+      REQUIRE_EXPANDS(simple("[-------------]"), "[$[]-[$]]", 15);
+      REQUIRE_EXPANDS(simple("-------------[]"), "-[[]]", 15);
+      REQUIRE_EXPANDS(simple("----<[asdf]>---"), "-[<[asdf]>]-", 15);
+      REQUIRE_EXPANDS(simple("[][][][][][][]["), "([])", 15);
+      REQUIRE_EXPANDS(simple("[()][()][()][()"), "([()])", 15);
+      REQUIRE_EXPANDS(simple("()-------------"), "[()]-", 15);
+      REQUIRE_EXPANDS(simple("([])-----------"), "[([])]-", 15);
+      REQUIRE_EXPANDS(simple("(()())()-------"), "[(()())()]-", 15);
    }
 
    SECTION("Colors") {
-      REQUIRE(colored("--------", "____kkkk") == expand_border_pattern("-($g0-)", 8));
-      REQUIRE(colored("--------", "____rrrr") == expand_border_pattern("-($g1-)", 8));
-      REQUIRE(colored("--------", "____gggg") == expand_border_pattern("-($g2-)", 8));
-      REQUIRE(colored("--------", "____yyyy") == expand_border_pattern("-($g3-)", 8));
-      REQUIRE(colored("--------", "____bbbb") == expand_border_pattern("-($g4-)", 8));
-      REQUIRE(colored("--------", "____pppp") == expand_border_pattern("-($g5-)", 8));
-      REQUIRE(colored("--------", "____cccc") == expand_border_pattern("-($g6-)", 8));
-      REQUIRE(colored("--------", "____wwww") == expand_border_pattern("-($g7-)", 8));
-      REQUIRE(colored("--------", "____KKKK") == expand_border_pattern("-($g8-)", 8));
-      REQUIRE(colored("--------", "____RRRR") == expand_border_pattern("-($g9-)", 8));
-      REQUIRE(colored("--------", "____GGGG") == expand_border_pattern("-($ga-)", 8));
-      REQUIRE(colored("--------", "____YYYY") == expand_border_pattern("-($gb-)", 8));
-      REQUIRE(colored("--------", "____BBBB") == expand_border_pattern("-($gc-)", 8));
-      REQUIRE(colored("--------", "____PPPP") == expand_border_pattern("-($gd-)", 8));
-      REQUIRE(colored("--------", "____CCCC") == expand_border_pattern("-($ge-)", 8));
-      REQUIRE(colored("--------", "____WWWW") == expand_border_pattern("-($gf-)", 8));
-      REQUIRE(colored("--------", "____GGGG") == expand_border_pattern("-($gA-)", 8));
-      REQUIRE(colored("--------", "____YYYY") == expand_border_pattern("-($gB-)", 8));
-      REQUIRE(colored("--------", "____BBBB") == expand_border_pattern("-($gC-)", 8));
-      REQUIRE(colored("--------", "____PPPP") == expand_border_pattern("-($gD-)", 8));
-      REQUIRE(colored("--------", "____CCCC") == expand_border_pattern("-($gE-)", 8));
-      REQUIRE(colored("--------", "____WWWW") == expand_border_pattern("-($gF-)", 8));
-
-      REQUIRE(colored("--------", "____gggg", "____rrrr") == expand_border_pattern("-($G12-)", 8));
-      REQUIRE(colored("--------", "_r_r_r_r") == expand_border_pattern("-$g1-", 8));
-      REQUIRE(colored("--------", "____r___") == expand_border_pattern("-[-$g1-]-", 8));
-      REQUIRE(colored("--------", "rgrg____", "_W_W____") == expand_border_pattern("($g1-$GF2-)-", 8));
+      REQUIRE_EXPANDS(colored("--------", "____kkkk"), "-($g0-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____rrrr"), "-($g1-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____gggg"), "-($g2-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____yyyy"), "-($g3-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____bbbb"), "-($g4-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____pppp"), "-($g5-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____cccc"), "-($g6-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____wwww"), "-($g7-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____KKKK"), "-($g8-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____RRRR"), "-($g9-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____GGGG"), "-($ga-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____YYYY"), "-($gb-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____BBBB"), "-($gc-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____PPPP"), "-($gd-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____CCCC"), "-($ge-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____WWWW"), "-($gf-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____GGGG"), "-($gA-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____YYYY"), "-($gB-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____BBBB"), "-($gC-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____PPPP"), "-($gD-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____CCCC"), "-($gE-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "____WWWW"), "-($gF-)", 8);
+
+      REQUIRE_EXPANDS(colored("--------", "____gggg", "____rrrr"), "-($G12-)", 8);
+      REQUIRE_EXPANDS(colored("--------", "_r_r_r_r"), "-$g1-", 8);
+      REQUIRE_EXPANDS(colored("--------", "____r___"), "-[-$g1-]-", 8);
+      REQUIRE_EXPANDS(colored("--------", "rgrg____", "_W_W____"), "($g1-$GF2-)-", 8);
    }
 
    SECTION("Patterns with no expandable groups result in appending spaces at the end if necessary") {
-      REQUIRE(simple("     ") == expand_border_pattern("", 5));
-      REQUIRE(simple("          ") == expand_border_pattern("", 10));
-      REQUIRE(simple("asdf      ") == expand_border_pattern("[asdf]", 10));
-      REQUIRE(simple("asdf      ") == expand_border_pattern("[a][s][d][f]", 10));
+      REQUIRE_EXPANDS(simple("     "), "", 5);
+      REQUIRE_EXPANDS(simple("          "), "", 10);
+      REQUIRE_EXPANDS(simple("asdf      "), "[asdf]", 10);
+      REQUIRE_EXPANDS(simple("asdf      "), "[a][s][d][f]", 10);
    }
 
    SECTION("Zero width patterns return an empty result") {
-      REQUIRE(simple("") == expand_border_pattern("", 0));
-      REQUIRE(simple("") == expand_border_pattern("-", 0));
-      REQUIRE(simple("") == expand_border_pattern("------", 0));
-      REQUIRE(simple("") == expand_border_pattern("(-)-[---]- (-)", 0));
+      REQUIRE_EXPANDS(simple(""), "", 0);
+      REQUIRE_EXPANDS(simple(""), "-", 0);
+      REQUIRE_EXPANDS(simple(""), "------", 0);
+      REQUIRE_EXPANDS(simple(""), "(-)-[---]- (-)", 0);
    }
 }
 
-#endif
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("expand_border_pattern() with cache", BE_CATCH_TAGS) {
+   std::vector<BorderChar> out;
+   for (int pass = 0; pass < 2; ++pass) {
+      expand_border_pattern("(-)=(-)=(-)=", 20, out);
+      REQUIRE(simple("----====---===---===") == out);
+      expand_border_pattern("(-)=(-)=(-)=", 9, out);
+      REQUIRE(simple("--==--=-=") == out);
+      expand_border_pattern("($g1-$GF2-)-", 8, out);
+      REQUIRE(colored("--------", "rgrg____", "_W_W____") == out);
+      expand_border_pattern(nullptr, 3, out);
+      REQUIRE(simple("   ") == out);
+   }
+}
 
+#endif
@@ -0,0 +1,284 @@
+#ifdef BE_TEST
+
+#include "border_renderer.hpp"
+#include "line_program.hpp"
+#include "text_renderer.hpp"
+#include <catch/catch.hpp>
+
+#define BE_CATCH_TAGS "[ct][ct:BorderRenderer]"
+
+using namespace be;
+using namespace be::ct;
+using namespace be::ct::detail;
+
+namespace {
+
+using vec_type = std::vector<BorderChar>;
+
+///////////////////////////////////////////////////////////////////////////////
+struct Box {
+   vec_type top;
+   vec_type right;
+   vec_type bottom;
+   vec_type left;
+   LogColor fg = LogColor::current;
+   LogColor bg = LogColor::current;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+Cell make_cell() {
+   Cell c;
+   c << "some text that wraps onto several lines";
+   return c;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Stream>
+void old_rule_char(Stream& os, BorderChar bc, LogColorState& color, const LogColorState& initial_color) {
+   if (bc.foreground == LogColor::current) {
+      bc.foreground = initial_color.fg;
+   }
+
+   if (bc.background == LogColor::current) {
+      bc.background = initial_color.bg;
+   }
+
+   if (color.fg != bc.foreground || color.bg != bc.background) {
+      color.fg = bc.foreground;
+      color.bg = bc.background;
+      os << color;
+   }
+
+   os << bc.glyph;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The rule rendering BorderRenderer used before rules were prepared:
+///        every glyph's colors are resolved as it is written.
+///
+/// \details Blanks past the end of the pattern are written as glyphs in the
+///         box colors.  The original wrote them with setcolor(fg, bg)
+///         without tracking the change, so with LogColor::current box
+///         colors they took on the colors of the glyph before them.
+template <typename Stream>
+void old_rule(Stream& os, const Box& box, const vec_type& vec, I32 inner_width) {
+   os << setcolor(box.fg, box.bg);
+   auto initial_color = get_color(os);
+   auto color = initial_color;
+
+   if (!box.left.empty()) {
+      old_rule_char(os, vec.empty() ? BorderChar() : vec.front(), color, initial_color);
+   }
+
+   for (int i = 0; i < inner_width; ++i) {
+      std::size_t index = (std::size_t)i + 1;
+      old_rule_char(os, index + 1 < vec.size() ? vec[index] : BorderChar(), color, initial_color);
+   }
+
+   if (!box.right.empty()) {
+      old_rule_char(os, vec.empty() ? BorderChar() : vec.back(), color, initial_color);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Stream>
+void old_side(Stream& os, const Box& box, const vec_type& vec, I32 inside_line) {
+   if (!vec.empty()) {
+      os << setcolor(box.fg, box.bg);
+      std::size_t index = (std::size_t)inside_line + 1;
+      if (index < vec.size()) {
+         auto bc = vec[index];
+         os << setcolor(bc.foreground, bc.background) << bc.glyph;
+      } else {
+         os << ' ';
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+LineProgram render_old(const Box& box, const Cell& cell, I32 width, I32 height) {
+   LineProgram program;
+   LineProgramWriter writer(program);
+   TextRenderer text(cell);
+   text.width(width);
+   text.height(height);
+
+   I32 total_width = width + (box.left.empty() ? 0 : 1) + (box.right.empty() ? 0 : 1);
+   I32 total_height = height + (box.top.empty() ? 0 : 1) + (box.bottom.empty() ? 0 : 1);
+   I32 inside_line = 0;
+   for (I32 line = 0; line < total_height; ++line) {
+      writer.begin_line(total_width);
+      auto base_color = get_color(writer);
+      if (line == 0 && !box.top.empty()) {
+         old_rule(writer, box, box.top, width);
+      } else if (line == total_height - 1 && !box.bottom.empty()) {
+         old_rule(writer, box, box.bottom, width);
+      } else {
+         old_side(writer, box, box.left, inside_line);
+         text(writer);
+         old_side(writer, box, box.right, inside_line);
+         ++inside_line;
+      }
+      writer << base_color;
+   }
+   return program;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+LineProgram render_new(BorderRenderer<TextRenderer>& border) {
+   LineProgram program;
+   LineProgramWriter writer(program);
+   while (border) {
+      writer.begin_line(border.width());
+      border(writer);
+   }
+   return program;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+LineProgram render_new(const Box& box, const Cell& cell, I32 width, I32 height) {
+   TextRenderer text(cell);
+   text.width(width);
+   text.height(height);
+   BorderRenderer<TextRenderer> border(text, box.top, box.right, box.bottom, box.left);
+   border.foreground(box.fg);
+   border.background(box.bg);
+   return render_new(border);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct ScreenCell {
+   char glyph;
+   LogColor fg;
+   LogColor bg;
+
+   bool operator==(const ScreenCell& other) const {
+      return glyph == other.glyph && fg == other.fg && bg == other.bg;
+   }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief What each line of a program leaves on the screen, so that programs
+///        which reach the same colors by different changes compare equal.
+std::vector<std::vector<ScreenCell>> screen(const LineProgram& program) {
+   std::vector<std::vector<ScreenCell>> lines;
+   for (std::size_t line = 0; line < program.size(); ++line) {
+      std::vector<ScreenCell> cells;
+      LogColorState color { LogColor::initial, LogColor::initial };
+      for (auto it = program.begin(line), end = program.end(line); it != end; ++it) {
+         const LineProgram::op& o = *it;
+         switch (o.type) {
+            case LineProgram::op_type::blank:
+            case LineProgram::op_type::glyph:
+               cells.insert(cells.end(), o.count, ScreenCell { o.glyph, color.fg, color.bg });
+               break;
+            case LineProgram::op_type::text:
+               for (char c : program.text(o)) {
+                  cells.push_back(ScreenCell { c, color.fg, color.bg });
+               }
+               break;
+            case LineProgram::op_type::color:
+               if (o.color.fg != LogColor::current) {
+                  color.fg = o.color.fg;
+               }
+               if (o.color.bg != LogColor::current) {
+                  color.bg = o.color.bg;
+               }
+               break;
+         }
+      }
+      lines.push_back(std::move(cells));
+   }
+   return lines;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+vec_type glyphs(const char* text, LogColor fg = LogColor::current, LogColor bg = LogColor::current) {
+   vec_type vec;
+   for (const char* c = text; *c; ++c) {
+      vec.push_back(BorderChar { *c, fg, bg });
+   }
+   return vec;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+vec_type operator+(vec_type a, const vec_type& b) {
+   a.insert(a.end(), b.begin(), b.end());
+   return a;
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Prepared border rules and sides match per-glyph rendering", BE_CATCH_TAGS) {
+   Cell cell = make_cell();
+   Box box;
+
+   SECTION("uncolored") {
+      box.top = glyphs("+------------+");
+      box.bottom = glyphs("+------------+");
+      box.left = glyphs("|||||");
+      box.right = glyphs("|||||");
+   }
+
+   SECTION("box colors") {
+      box.top = glyphs("+------------+");
+      box.bottom = glyphs("+------------+");
+      box.left = glyphs("|||||");
+      box.right = glyphs("|||||");
+      box.fg = LogColor::yellow;
+      box.bg = LogColor::blue;
+   }
+
+   SECTION("color runs") {
+      box.top = glyphs("+", LogColor::red) + glyphs("--", LogColor::green) + glyphs("--") + glyphs("==", LogColor::green, LogColor::black)
+         + glyphs("--", LogColor::current, LogColor::purple) + glyphs("+", LogColor::red);
+      box.bottom = glyphs("#") + glyphs("~~~", LogColor::cyan) + glyphs("~~~", LogColor::cyan) + glyphs("#");
+      box.left = glyphs("+", LogColor::red) + glyphs("|") + glyphs("!", LogColor::bright_red, LogColor::gray);
+      box.right = glyphs("+") + glyphs("|", LogColor::current, LogColor::white) + glyphs("||");
+      box.fg = LogColor::yellow;
+   }
+
+   SECTION("sides only") {
+      box.left = glyphs("[[", LogColor::green);
+      box.right = glyphs("]]]]]]]");
+      box.bg = LogColor::dark_gray;
+   }
+
+   SECTION("rules only") {
+      box.top = glyphs("/", LogColor::red) + glyphs("=", LogColor::red) + glyphs("\\");
+      box.bottom = glyphs("\\__/", LogColor::current, LogColor::blue);
+      box.fg = LogColor::white;
+   }
+
+   for (I32 width : { 0, 1, 6, 12, 20 }) {
+      for (I32 height : { 1, 3, 6 }) {
+         REQUIRE(screen(render_new(box, cell, width, height)) == screen(render_old(box, cell, width, height)));
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("BorderRenderer prepares its borders again when refrozen", BE_CATCH_TAGS) {
+   Cell cell = make_cell();
+   Box box;
+   box.top = glyphs("+", LogColor::red) + glyphs("------", LogColor::green) + glyphs("+", LogColor::red);
+   box.left = glyphs("|", LogColor::red) + glyphs("|||", LogColor::green, LogColor::blue);
+
+   TextRenderer text(cell);
+   text.width(6);
+   text.height(3);
+   BorderRenderer<TextRenderer> border(text, box.top, box.right, box.bottom, box.left);
+   REQUIRE(screen(render_new(border)) == screen(render_old(box, cell, 6, 3)));
+
+   box.top[3].foreground = LogColor::blue;
+   border.top()[3].foreground = LogColor::blue;
+   box.left[2].background = LogColor::current;
+   border.left()[2].background = LogColor::current;
+   box.fg = LogColor::cyan;
+   border.foreground(LogColor::cyan);
+   border.thaw();
+   REQUIRE(screen(render_new(border)) == screen(render_old(box, cell, 6, 3)));
+}
+
+#endif
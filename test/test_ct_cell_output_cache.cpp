@@ -0,0 +1,89 @@
+#ifdef BE_TEST
+
+#include "cell_output_cache.hpp"
+#include "table.hpp"
+#include "table_renderer.hpp"
+#include <catch/catch.hpp>
+#include <sstream>
+
+#define BE_CATCH_TAGS "[ct][ct:CellOutputCache]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+Table make_table(const char* status) {
+   TableConfig config;
+   set_border(config.box, BorderConfig { 1, 1, LogColor::current, "-" }, BorderConfig { 1, 1, LogColor::current, "|" });
+   Table t(config);
+   t << header << cell << "Service" << cell << "Status";
+   t << row << cell << "database" << cell << setcolor(LogColor::green) << status;
+   t << row << cell << "queue" << cell << "a longer status message " << setcolor(LogColor::yellow) << "that has to wrap";
+   return t;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+S render_with(const Table& table, I32 width, CellOutputCache* cache) {
+   std::ostringstream os;
+   detail::TableRenderer r(table);
+   r.output_cache(cache);
+   r.auto_size(width);
+   r.combine_border_corners();
+   while (r) {
+      os << nl;
+      r(os);
+   }
+   return os.str();
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("CellOutputCache output matches uncached rendering", BE_CATCH_TAGS) {
+   CellOutputCache cache;
+
+   for (I32 width : { 60, 25, 12 }) {
+      S expected = render_with(make_table("ok"), width, nullptr);
+      REQUIRE(render_with(make_table("ok"), width, &cache) == expected);
+      REQUIRE(render_with(make_table("ok"), width, &cache) == expected);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("CellOutputCache only formats changed cells again", BE_CATCH_TAGS) {
+   CellOutputCache cache;
+
+   render_with(make_table("ok"), 30, &cache);
+   REQUIRE(cache.size() == 6);
+   REQUIRE(cache.hits() == 0);
+
+   render_with(make_table("ok"), 30, &cache);
+   REQUIRE(cache.size() == 6);
+   REQUIRE(cache.hits() == 6);
+
+   Table t = make_table("ok");
+   t.back().back() << "!";
+   REQUIRE(render_with(t, 30, &cache) == render_with(t, 30, nullptr));
+   REQUIRE(cache.size() == 7);
+   REQUIRE(cache.hits() == 11);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("CellOutputCache evicts the least recently used cells", BE_CATCH_TAGS) {
+   CellOutputCache cache(2);
+   auto program = std::make_shared<const LineProgram>();
+
+   cache.insert({ 1, 10, 1, 0 }, program);
+   cache.insert({ 2, 10, 1, 0 }, program);
+   REQUIRE(cache.find({ 1, 10, 1, 0 }) == program);
+   cache.insert({ 3, 10, 1, 0 }, program);
+
+   REQUIRE(cache.size() == 2);
+   REQUIRE(cache.find({ 2, 10, 1, 0 }) == nullptr);
+   REQUIRE(cache.find({ 1, 10, 1, 0 }) == program);
+   REQUIRE(cache.find({ 1, 11, 1, 0 }) == nullptr);
+}
+
+#endif
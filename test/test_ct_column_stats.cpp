@@ -0,0 +1,79 @@
+#ifdef BE_TEST
+
+#include "table.hpp"
+#include <catch/catch.hpp>
+
+#define BE_CATCH_TAGS "[ct][ct:Table][ct:ColumnStats]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+Table make_table(bool track) {
+   TableConfig config;
+   set_border(config.box, BorderConfig { 1, 1, LogColor::current, "-" }, BorderConfig { 1, 1, LogColor::current, "|" });
+   Table t(config);
+   t.track_column_stats(track);
+   t << header << cell << "Key" << cell << "Value";
+   for (int i = 0; i < 20; ++i) {
+      t << row << cell << "key " << i << cell << S(i % 7 * 3, 'v') << " " << i;
+   }
+   return t;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+S render_to_string(const Table& table, I32 width) {
+   S out;
+   LineEncoder().encode(compile(table, width), out);
+   return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void require_same_layout(const Table& tracked, const Table& untracked) {
+   REQUIRE(tracked.tracking_column_stats());
+   REQUIRE_FALSE(untracked.tracking_column_stats());
+   for (I32 width : { 80, 24 }) {
+      REQUIRE(render_to_string(tracked, width) == render_to_string(untracked, width));
+   }
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Tracked column stats give the same layout as measuring", BE_CATCH_TAGS) {
+   Table tracked = make_table(true);
+   Table untracked = make_table(false);
+   require_same_layout(tracked, untracked);
+
+   SECTION("after appending cells") {
+      tracked << cell << "a much longer trailing value";
+      untracked << cell << "a much longer trailing value";
+      require_same_layout(tracked, untracked);
+   }
+
+   SECTION("after editing an earlier row") {
+      tracked[3] << cell << "extra wide cell added to an early row";
+      untracked[3] << cell << "extra wide cell added to an early row";
+      require_same_layout(tracked, untracked);
+
+      for (Row& row : tracked) {
+         row.back() << "!!!!!!!!!!!!!!!!!!!!";
+         break;
+      }
+      for (Row& row : untracked) {
+         row.back() << "!!!!!!!!!!!!!!!!!!!!";
+         break;
+      }
+      require_same_layout(tracked, untracked);
+   }
+
+   SECTION("after changing the width policy") {
+      tracked.config().pref_width_percentile = 50;
+      untracked.config().pref_width_percentile = 50;
+      require_same_layout(tracked, untracked);
+   }
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifdef BE_TEST
+
+#include "frame_scheduler.hpp"
+#include <catch/catch.hpp>
+#include <sstream>
+
+#define BE_CATCH_TAGS "[ct][ct:FrameScheduler]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+Table make_table(int value) {
+   Table t;
+   t << row << cell << "value" << cell << value;
+   return t;
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("FrameScheduler coalesces and rate limits frames", BE_CATCH_TAGS) {
+   std::ostringstream os;
+   FrameScheduler scheduler(os, 0.001);
+
+   REQUIRE_FALSE(scheduler.tick());
+
+   scheduler.submit(make_table(1));
+   scheduler.submit(make_table(2));
+   scheduler.submit(make_table(3));
+   REQUIRE(scheduler.tick());
+   REQUIRE(scheduler.frames() == 1);
+   REQUIRE(scheduler.coalesced() == 2);
+   REQUIRE(os.str().find('3') != S::npos);
+   REQUIRE(os.str().find('1') == S::npos);
+
+   scheduler.submit(make_table(4));
+   REQUIRE_FALSE(scheduler.tick());
+   REQUIRE(scheduler.frames() == 1);
+
+   scheduler.stop();
+   REQUIRE(scheduler.frames() == 2);
+   REQUIRE(os.str().find('4') != S::npos);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("FrameScheduler draws from its own thread", BE_CATCH_TAGS) {
+   std::ostringstream os;
+   FrameScheduler scheduler(os, 1000);
+   scheduler.start();
+
+   for (int i = 0; i < 100; ++i) {
+      scheduler.submit(make_table(i));
+   }
+
+   scheduler.stop();
+   REQUIRE(scheduler.frames() + scheduler.coalesced() == 100);
+   REQUIRE(os.str().find("99") != S::npos);
+}
+
+#endif
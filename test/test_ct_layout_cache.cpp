@@ -0,0 +1,80 @@
+#ifdef BE_TEST
+
+#include "layout_cache.hpp"
+#include "table.hpp"
+#include "table_renderer.hpp"
+#include <catch/catch.hpp>
+#include <sstream>
+
+#define BE_CATCH_TAGS "[ct][ct:LayoutCache]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+Table make_table(const char* status) {
+   TableConfig config;
+   set_border(config.box, BorderConfig { 1, 1, LogColor::current, "-" }, BorderConfig { 1, 1, LogColor::current, "|" });
+   Table t(config);
+   t << header << cell << "Service" << cell << "Status";
+   t << row << cell << "database" << cell << status;
+   t << row << cell << "queue" << cell << "a longer status message that has to wrap";
+   return t;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+S render_with(const Table& table, I32 width, LayoutCache* cache) {
+   std::ostringstream os;
+   detail::TableRenderer r(table);
+   if (cache) {
+      r.auto_size(width, table.hash(), *cache);
+   } else {
+      r.auto_size(width);
+   }
+   r.combine_border_corners();
+   while (r) {
+      os << nl;
+      r(os);
+   }
+   return os.str();
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Table::hash() depends only on content and sizing config", BE_CATCH_TAGS) {
+   REQUIRE(make_table("ok").hash() == make_table("ok").hash());
+   REQUIRE(make_table("ok").hash() != make_table("down").hash());
+
+   Table t = make_table("ok");
+   U64 hash = t.hash();
+   t.back().back() << "!";
+   REQUIRE(t.hash() != hash);
+
+   Table padded = make_table("ok");
+   padded.config().box.sides[BoxConfig::left_side].padding = 3;
+   REQUIRE(padded.hash() != hash);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("LayoutCache reuses layouts for identical tables", BE_CATCH_TAGS) {
+   LayoutCache cache(2);
+
+   S first = render_with(make_table("ok"), 30, &cache);
+   REQUIRE(cache.size() == 1);
+   REQUIRE(first == render_with(make_table("ok"), 30, nullptr));
+
+   REQUIRE(cache.find(make_table("ok").hash(), 30) != nullptr);
+   REQUIRE(render_with(make_table("ok"), 30, &cache) == first);
+   REQUIRE(cache.size() == 1);
+
+   render_with(make_table("ok"), 20, &cache);
+   render_with(make_table("down"), 30, &cache);
+   REQUIRE(cache.size() == 2);
+   REQUIRE(cache.find(make_table("ok").hash(), 30) == nullptr);
+   REQUIRE(cache.find(make_table("ok").hash(), 20) != nullptr);
+}
+
+#endif
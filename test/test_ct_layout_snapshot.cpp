@@ -0,0 +1,78 @@
+#ifdef BE_TEST
+
+#include "table.hpp"
+#include "table_renderer.hpp"
+#include <catch/catch.hpp>
+#include <sstream>
+
+#define BE_CATCH_TAGS "[ct][ct:LayoutSnapshot]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+Table make_table() {
+   TableConfig config;
+   set_border(config.box, BorderConfig { 1, 1, LogColor::current, "=" }, BorderConfig { 1, 2, LogColor::current, "|" });
+   Table t(config);
+   t << header << cell << "Name" << cell << "Description" << cell << "N";
+   for (int i = 0; i < 6; ++i) {
+      t << row << cell << "item " << i << cell << "some words that wrap around when narrow" << cell << i * 1234;
+   }
+   return t;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+S render_auto_sized(const Table& table, I32 width) {
+   std::ostringstream os;
+   detail::TableRenderer r(table);
+   r.auto_size(width);
+   r.combine_border_corners();
+   while (r) {
+      os << nl;
+      r(os);
+   }
+   return os.str();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+S render_with_layout(const Table& table, const LayoutSnapshot& snapshot) {
+   std::ostringstream os;
+   render(os, table, snapshot);
+   return os.str();
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Rendering with a layout snapshot matches auto_size()", BE_CATCH_TAGS) {
+   Table table = make_table();
+
+   for (I32 width : { 120, 40, 25 }) {
+      S expected = render_auto_sized(table, width);
+      LayoutSnapshot snapshot = layout(table, width);
+      REQUIRE(snapshot.rows.size() == table.size());
+      REQUIRE(render_with_layout(table, snapshot) == expected);
+
+      snapshot.rows.clear();
+      REQUIRE(render_with_layout(table, snapshot) == expected);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Layout snapshots must match the table's shape", BE_CATCH_TAGS) {
+   Table table = make_table();
+   LayoutSnapshot snapshot = layout(table, 40);
+
+   LayoutSnapshot extra_column = snapshot;
+   extra_column.columns.push_back(ColumnLayout());
+   REQUIRE_THROWS_AS(render_with_layout(table, extra_column), std::invalid_argument);
+
+   LayoutSnapshot missing_row = snapshot;
+   missing_row.rows.pop_back();
+   REQUIRE_THROWS_AS(render_with_layout(table, missing_row), std::invalid_argument);
+}
+
+#endif
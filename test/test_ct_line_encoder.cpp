@@ -0,0 +1,164 @@
+#ifdef BE_TEST
+
+#include "line_encoder.hpp"
+#include "mapped_file.hpp"
+#include "table.hpp"
+#include <catch/catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#define BE_CATCH_TAGS "[ct][ct:LineEncoder]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+Table make_table() {
+   TableConfig config;
+   set_border(config.box, BorderConfig { 1, 1, LogColor::blue, "=" }, BorderConfig { 1, 1, LogColor::current, "|" });
+   Table t(config);
+   t << header << cell << setcolor(LogColor::red) << "Name" << cell << "Description" << cell << setcolor(LogColor::bright_green, LogColor::blue) << "N";
+   for (int i = 0; i < 5; ++i) {
+      t << row << cell << "item " << i << cell << "some words that wrap around when narrow" << cell << i * 1234;
+   }
+   return t;
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("LineEncoder sizes are exact", BE_CATCH_TAGS) {
+   Table table = make_table();
+
+   for (int mode = 0; mode < 8; ++mode) {
+      bool color = (mode & 1) != 0;
+      EncoderConfig config;
+      config.color = color;
+      config.trim_trailing_blanks = (mode & 2) != 0;
+      config.cursor_forward_threshold = (mode & 4) != 0 ? 5 : 0;
+      LineEncoder encoder(config);
+
+      for (I32 width : { 200, 40, 5 }) {
+         LineProgram program = compile(table, width);
+
+         S out;
+         encoder.encode(program, out);
+         REQUIRE(out.size() == encoder.size(program));
+
+         std::size_t offset = 0;
+         for (std::size_t line = 0; line < program.size(); ++line) {
+            std::size_t size = encoder.line_size(program, line);
+            S buf(size, '\0');
+            REQUIRE(encoder.encode_line(program, line, &buf[0]) == &buf[0] + size);
+            REQUIRE(out.compare(offset, size, buf) == 0);
+            REQUIRE(out[offset + size] == '\n');
+            offset += size + 1;
+            if (!color && !config.trim_trailing_blanks && config.cursor_forward_threshold == 0) {
+               REQUIRE(size == (std::size_t)program.width());
+            }
+         }
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("LineEncoder trailing blank suppression", BE_CATCH_TAGS) {
+   Table table;
+   table << row << cell << "a" << cell << "b";
+   table << row << cell << "longer text" << cell << "c";
+   LineProgram program = compile(table, 40);
+
+   EncoderConfig config;
+   config.color = false;
+   S full;
+   LineEncoder(config).encode(program, full);
+
+   config.trim_trailing_blanks = true;
+   S trimmed;
+   LineEncoder(config).encode(program, trimmed);
+
+   REQUIRE(full == "a          b\nlonger textc\n");
+   REQUIRE(trimmed == "a          b\nlonger textc\n");
+
+   table << row << cell << "d";
+   program = compile(table, 40);
+   trimmed.clear();
+   LineEncoder(config).encode(program, trimmed);
+   REQUIRE(trimmed == "a          b\nlonger textc\nd\n");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("LineEncoder cursor forward runs", BE_CATCH_TAGS) {
+   Table table;
+   table << row << cell << "a" << cell << "b";
+   table << row << cell << "longer text" << cell << "c";
+   LineProgram program = compile(table, 40);
+
+   EncoderConfig config;
+   config.color = false;
+   config.cursor_forward_threshold = 10;
+   S out;
+   LineEncoder(config).encode(program, out);
+   REQUIRE(out == "a\x1b[10Cb\nlonger textc\n");
+
+   config.cursor_forward_threshold = 11;
+   out.clear();
+   LineEncoder(config).encode(program, out);
+   REQUIRE(out == "a          b\nlonger textc\n");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("write_mapped_file()", BE_CATCH_TAGS) {
+   LineProgram program = compile(make_table(), 40);
+   LineEncoder encoder;
+   S expected;
+   encoder.encode(program, expected);
+
+   const char* path = "test_ct_line_encoder.tmp";
+   write_mapped_file(path, program, encoder);
+
+   S actual;
+   {
+      std::ifstream ifs(path, std::ios::binary);
+      actual.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+   }
+   std::remove(path);
+
+   REQUIRE(actual == expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("write_mapped_file() from a table", BE_CATCH_TAGS) {
+   Table table = make_table();
+   EncoderConfig config;
+   config.trim_trailing_blanks = true;
+   LineEncoder encoder(config);
+
+   SECTION("proportional column widths") { }
+
+   SECTION("line count solver") {
+      table.config().line_count_budget_ms = 1000;
+   }
+
+   for (I32 width : { 25, 40, 120 }) {
+      S expected;
+      encoder.encode(compile(table, width), expected);
+
+      const char* path = "test_ct_line_encoder.tmp";
+      write_mapped_file(path, table, width, encoder);
+
+      S actual;
+      {
+         std::ifstream ifs(path, std::ios::binary);
+         actual.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+      }
+      std::remove(path);
+
+      REQUIRE(actual == expected);
+   }
+}
+
+#endif
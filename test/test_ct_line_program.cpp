@@ -0,0 +1,76 @@
+#ifdef BE_TEST
+
+#include "line_program.hpp"
+#include "table.hpp"
+#include "table_renderer.hpp"
+#include <catch/catch.hpp>
+#include <sstream>
+
+#define BE_CATCH_TAGS "[ct][ct:LineProgram]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+Table make_table() {
+   TableConfig config;
+   set_border(config.box, BorderConfig { 1, 1, LogColor::current, "=" }, BorderConfig { 1, 1, LogColor::current, "|" });
+   Table t(config);
+   t << header << cell << "Name" << cell << "Description" << cell << "N";
+   for (int i = 0; i < 5; ++i) {
+      t << row << cell << "item " << i << cell << "some words that wrap around when narrow" << cell << i * 1234;
+   }
+   return t;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+S render_tree(const Table& table, I32 width) {
+   std::ostringstream os;
+   detail::TableRenderer r(table);
+   r.auto_size(width);
+   r.combine_border_corners();
+   while (r) {
+      os << nl;
+      r(os);
+   }
+   return os.str();
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("LineProgram output matches the renderer tree", BE_CATCH_TAGS) {
+   Table table = make_table();
+
+   for (I32 width : { 200, 40, 20, 5 }) {
+      LineProgram program = compile(table, width);
+      std::ostringstream os;
+      program.render(os);
+      REQUIRE(os.str() == render_tree(table, width));
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("LineProgram lines can be rendered individually", BE_CATCH_TAGS) {
+   Table table = make_table();
+   LineProgram program = compile(table, 40);
+
+   REQUIRE(program.width() <= 40);
+
+   std::ostringstream all;
+   program.render(all);
+
+   std::ostringstream each;
+   for (std::size_t line = 0; line < program.size(); ++line) {
+      std::ostringstream os;
+      program.render_line(os, line);
+      REQUIRE(os.str().size() == (std::size_t)program.width());
+      each << nl << os.str();
+   }
+
+   REQUIRE(each.str() == all.str());
+}
+
+#endif
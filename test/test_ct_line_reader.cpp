@@ -0,0 +1,82 @@
+#ifdef BE_TEST
+
+#include "line_reader.hpp"
+#include <catch/catch.hpp>
+
+#define BE_CATCH_TAGS "[ct][ct:LineReader]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+Table make_table() {
+   TableConfig config;
+   set_border(config.box, BorderConfig { 1, 1, LogColor::blue, "=" }, BorderConfig { 1, 1, LogColor::current, "|" });
+   Table t(config);
+   t << header << cell << "Name" << cell << setcolor(LogColor::red) << "Description";
+   for (int i = 0; i < 3; ++i) {
+      t << row << cell << "item " << i << cell << "some words that wrap around when narrow";
+   }
+   return t;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+S expected_lines(const Table& table, I32 width) {
+   S out;
+   LineEncoder().encode(compile(table, width), out);
+   return out;
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("LineReader yields the same lines as LineEncoder", BE_CATCH_TAGS) {
+   Table table = make_table();
+
+   for (I32 width : { 80, 20 }) {
+      S joined;
+      LineReader reader(table, width);
+      for (std::string_view line : reader) {
+         joined.append(line);
+         joined.push_back('\n');
+      }
+      REQUIRE(joined == expected_lines(table, width));
+
+      std::string_view line;
+      REQUIRE_FALSE(reader.next(line));
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("LineReader renders with a precomputed layout", BE_CATCH_TAGS) {
+   Table table = make_table();
+
+   for (I32 width : { 80, 20 }) {
+      S joined;
+      for (std::string_view line : LineReader(table, layout(table, width))) {
+         joined.append(line);
+         joined.push_back('\n');
+      }
+      REQUIRE(joined == expected_lines(table, width));
+   }
+}
+
+#ifdef BE_CTABLE_COROUTINES
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("generate_lines() yields the same lines as LineReader", BE_CATCH_TAGS) {
+   Table table = make_table();
+
+   S joined;
+   for (std::string_view line : generate_lines(table, 20)) {
+      joined.append(line);
+      joined.push_back('\n');
+   }
+   REQUIRE(joined == expected_lines(table, 20));
+}
+
+#endif
+
+#endif
@@ -0,0 +1,59 @@
+#ifdef BE_TEST
+
+#include "live_display.hpp"
+#include "table.hpp"
+#include <catch/catch.hpp>
+
+#define BE_CATCH_TAGS "[ct][ct:LiveDisplay]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+LineProgram make_frame(std::initializer_list<const char*> values) {
+   Table t;
+   for (const char* value : values) {
+      t << row << cell << value;
+   }
+   return compile(t, 20);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+S update(LiveDisplay& display, std::initializer_list<const char*> values) {
+   S out;
+   display.update(make_frame(values), out);
+   return out;
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("LiveDisplay draws every line of the first frame", BE_CATCH_TAGS) {
+   EncoderConfig config;
+   config.color = false;
+   LiveDisplay display(config);
+
+   REQUIRE(update(display, { "a", "b" }) == "\r\x1b[Ka\n\r\x1b[Kb\n\r");
+   REQUIRE(display.lines() == 2);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("LiveDisplay only redraws changed lines", BE_CATCH_TAGS) {
+   EncoderConfig config;
+   config.color = false;
+   LiveDisplay display(config);
+   update(display, { "a", "b", "c" });
+
+   REQUIRE(update(display, { "a", "b", "c" }) == "\r");
+   REQUIRE(update(display, { "a", "x", "c" }) == "\x1b[2A\r\x1b[Kx\x1b[2B\r");
+   REQUIRE(update(display, { "a", "x", "c", "d" }) == "\r\x1b[Kd\n\r");
+   REQUIRE(update(display, { "y", "x" }) == "\x1b[4A\r\x1b[Ky\x1b[2B\r\x1b[J");
+   REQUIRE(display.lines() == 2);
+
+   display.reset();
+   REQUIRE(update(display, { "y" }) == "\r\x1b[Ky\n\r");
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifdef BE_TEST
+
+#include "live_layout.hpp"
+#include "table.hpp"
+#include <catch/catch.hpp>
+#include <sstream>
+
+#define BE_CATCH_TAGS "[ct][ct:LiveLayout]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+Table make_table(const S& value) {
+   Table t;
+   t << header << cell << "Name" << cell << "Value";
+   t << row << cell << "counter" << cell << value;
+   return t;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+I32 value_width(const LiveLayout& live) {
+   return live.layout().columns.back().internal_width;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void frame(LiveLayout& live, const S& value) {
+   std::ostringstream os;
+   render(os, make_table(value), live);
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("LiveLayout keeps widths while values fit", BE_CATCH_TAGS) {
+   LiveLayout live(2, 3);
+
+   frame(live, "12345678");
+   REQUIRE(live.layouts() == 1);
+   REQUIRE(value_width(live) == 8);
+
+   frame(live, "1234567");
+   frame(live, "123456");
+   REQUIRE(live.layouts() == 1);
+   REQUIRE(value_width(live) == 8);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("LiveLayout grows immediately", BE_CATCH_TAGS) {
+   LiveLayout live(2, 3);
+
+   frame(live, "123");
+   frame(live, "1234567890");
+   REQUIRE(live.layouts() == 2);
+   REQUIRE(value_width(live) == 10);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("LiveLayout shrinks after consecutive frames", BE_CATCH_TAGS) {
+   LiveLayout live(2, 3);
+
+   frame(live, "1234567890");
+   frame(live, "12");
+   frame(live, "12");
+   REQUIRE(live.layouts() == 1);
+
+   frame(live, "1234567890");
+   frame(live, "12");
+   frame(live, "12");
+   REQUIRE(live.layouts() == 1);
+
+   frame(live, "12");
+   REQUIRE(live.layouts() == 2);
+   REQUIRE(value_width(live) == 5);
+}
+
+#endif
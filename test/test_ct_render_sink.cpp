@@ -0,0 +1,42 @@
+#ifdef BE_TEST
+
+#include "render_sink.hpp"
+#include <catch/catch.hpp>
+#include <sstream>
+
+#define BE_CATCH_TAGS "[ct][ct:RenderSink]"
+
+using namespace be;
+using namespace be::ct;
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("render() writes one layout to several sinks", BE_CATCH_TAGS) {
+   TableConfig config;
+   set_border(config.box, BorderConfig { 1, 1, LogColor::blue, "=" }, BorderConfig { 1, 1, LogColor::current, "|" });
+   Table table(config);
+   table << header << cell << "Name" << cell << "Description";
+   table << row << cell << "item" << cell << "some words that wrap around when narrow";
+
+   std::ostringstream console, ansi, plain;
+   render(table, 30, { console_sink(console), ansi_sink(ansi), plain_sink(plain) });
+
+   LineProgram program = compile(table, 30);
+
+   std::ostringstream expected_console;
+   program.render(expected_console);
+   REQUIRE(console.str() == expected_console.str());
+
+   S expected_ansi;
+   LineEncoder().encode(program, expected_ansi);
+   REQUIRE(ansi.str() == expected_ansi);
+
+   EncoderConfig plain_config;
+   plain_config.color = false;
+   S expected_plain;
+   LineEncoder(plain_config).encode(program, expected_plain);
+   REQUIRE(plain.str() == expected_plain);
+   REQUIRE(plain.str().find('\x1b') == S::npos);
+   REQUIRE(ansi.str().find('\x1b') != S::npos);
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifdef BE_TEST
+
+#include "cell_renderer.hpp"
+#include "hseq_renderer.hpp"
+#include <catch/catch.hpp>
+
+#define BE_CATCH_TAGS "[ct][ct:BaseRenderer]"
+
+using namespace be;
+using namespace be::ct;
+using namespace be::ct::detail;
+
+namespace {
+
+using seq_type = HSeqRenderer<CellRenderer>;
+using padded_type = PaddedRenderer<seq_type>;
+using border_type = BorderRenderer<padded_type>;
+
+///////////////////////////////////////////////////////////////////////////////
+Cell make_cell(const char* text) {
+   Cell c;
+   c << text;
+   return c;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Two cells in a padded, bordered sequence, so that a change to the
+///        first cell's innermost renderer has five ancestors above it.
+struct Tree {
+   Cell a;
+   Cell b;
+   CellRenderer first;
+   CellRenderer second;
+   seq_type seq;
+   padded_type padding;
+   border_type border;
+
+   Tree()
+      : a(make_cell("first")),
+        b(make_cell("second")),
+        first(a),
+        second(b),
+        padding(seq, 1, 2, 1, 2),
+        border(padding)
+   {
+      seq.add(&first);
+      seq.add(&second);
+      border.enabled(BoxConfig::left_side, true);
+      border.enabled(BoxConfig::right_side, true);
+      first.text.width(5);
+      first.text.height(1);
+      second.text.width(6);
+      second.text.height(1);
+   }
+
+   /// \brief Queries every renderer, so each memoizes its dimensions, and
+   ///        checks them against the leaves.
+   void check(I32 first_width, I32 first_height) {
+      REQUIRE(first.width() == first_width);
+      REQUIRE(first.height() == first_height);
+      REQUIRE(seq.width() == first_width + second.width());
+      REQUIRE(seq.height() == std::max(first_height, second.height()));
+      REQUIRE(padding.width() == seq.width() + 4);
+      REQUIRE(padding.height() == seq.height() + 2);
+      REQUIRE(border.width() == padding.width() + 2);
+      REQUIRE(border.height() == padding.height());
+   }
+};
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Setters invalidate the memoized dimensions of every ancestor", BE_CATCH_TAGS) {
+   Tree t;
+   t.check(5, 1);
+   REQUIRE(t.border.width() == 5 + 6 + 4 + 2);
+   REQUIRE(t.border.height() == 1 + 2);
+
+   SECTION("text width") {
+      t.first.text.width(9);
+      t.check(9, 1);
+   }
+
+   SECTION("text height") {
+      t.first.text.height(4);
+      t.check(5, 4);
+   }
+
+   SECTION("padding") {
+      t.first.padding.left(3);
+      t.first.padding.bottom(2);
+      t.check(8, 3);
+   }
+
+   SECTION("border enable") {
+      t.first.border.enabled(BoxConfig::right_side, true);
+      t.first.border.enabled(BoxConfig::top_side, true);
+      t.check(6, 2);
+   }
+
+   SECTION("margin") {
+      t.first.margin.right(2);
+      t.check(7, 1);
+   }
+}
+
+#endif
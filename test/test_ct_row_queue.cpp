@@ -0,0 +1,94 @@
+#ifdef BE_TEST
+
+#include "stream_renderer.hpp"
+#include <catch/catch.hpp>
+#include <sstream>
+#include <thread>
+
+#define BE_CATCH_TAGS "[ct][ct:RowQueue]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+Row make_row(int producer, int value) {
+   Row r;
+   r << cell << "producer " << producer << cell << value;
+   return r;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<S> split_lines(const S& str) {
+   std::vector<S> lines;
+   std::istringstream is(str);
+   S line;
+   while (std::getline(is, line)) {
+      if (!line.empty()) {
+         lines.push_back(line);
+      }
+   }
+   return lines;
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("RowQueue drop policy", BE_CATCH_TAGS) {
+   REQUIRE(RowQueue(5).capacity() == 8);
+   REQUIRE_THROWS_AS(RowQueue(1), std::invalid_argument);
+
+   RowQueue queue(2, RowQueue::overflow_policy::drop);
+   REQUIRE(queue.push(make_row(0, 1)));
+   REQUIRE(queue.push(make_row(0, 2)));
+   REQUIRE_FALSE(queue.push(make_row(0, 3)));
+   REQUIRE(queue.dropped() == 1);
+
+   Row row;
+   REQUIRE(queue.try_pop(row));
+   REQUIRE(row.size() == 2);
+   REQUIRE(queue.push(make_row(0, 4)));
+   REQUIRE(queue.try_pop(row));
+   REQUIRE(queue.try_pop(row));
+   REQUIRE_FALSE(queue.try_pop(row));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("RowQueue feeds a StreamRenderer from many threads", BE_CATCH_TAGS) {
+   const int producers = 4;
+   const int rows_per_producer = 500;
+
+   RowQueue queue(16);
+   std::ostringstream os;
+   StreamRenderer renderer(os, TableConfig(), 80);
+
+   std::vector<std::thread> threads;
+   for (int p = 0; p < producers; ++p) {
+      threads.emplace_back([&queue, p]() {
+         for (int i = 0; i < rows_per_producer; ++i) {
+            queue.push(make_row(p, i < rows_per_producer - 1 ? i : 1000000 + i));
+         }
+      });
+   }
+
+   std::size_t total = 0;
+   while (total < producers * rows_per_producer) {
+      total += renderer.drain(queue, 7);
+   }
+   for (std::thread& t : threads) {
+      t.join();
+   }
+
+   REQUIRE(total == producers * rows_per_producer);
+   REQUIRE(renderer.rows() == total);
+   REQUIRE(queue.dropped() == 0);
+
+   std::vector<S> lines = split_lines(os.str());
+   REQUIRE(lines.size() == total);
+   for (std::size_t i = 1; i < lines.size(); ++i) {
+      REQUIRE(lines[i].size() >= lines[i - 1].size());
+   }
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifdef BE_TEST
+
+#include "table.hpp"
+#include <catch/catch.hpp>
+#include <thread>
+
+#define BE_CATCH_TAGS "[ct][ct:Table][ct:seal]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+Table make_table() {
+   TableConfig config;
+   set_border(config.box, BorderConfig { 1, 1, LogColor::current, "-" }, BorderConfig { 1, 1, LogColor::current, "|" });
+   Table t(config);
+   t.track_column_stats(true);
+   t << header << cell << "Name" << cell << "Value";
+   for (int i = 0; i < 50; ++i) {
+      t << row << cell << "row " << i << cell << "some text that wraps " << i * 37;
+   }
+   return t;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+S render_to_string(const Table& table) {
+   S out;
+   LineEncoder().encode(compile(table, 30), out);
+   return out;
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Table::seal() cleans cells until the table is modified", BE_CATCH_TAGS) {
+   Table t = make_table();
+   REQUIRE(t.back().back().dirty());
+   REQUIRE_FALSE(t.sealed());
+
+   t.seal();
+   REQUIRE(t.sealed());
+   const Table& ct = t;
+   REQUIRE_FALSE(ct.back().back().dirty());
+   REQUIRE(ct.column_stats().size() == 2);
+
+   t.back().back() << "!";
+   REQUIRE_FALSE(t.sealed());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Sealed tables can be rendered from many threads", BE_CATCH_TAGS) {
+   S expected = render_to_string(make_table());
+   std::shared_ptr<const Table> table = seal(make_table());
+
+   std::vector<S> results(8);
+   std::vector<std::thread> threads;
+   for (S& result : results) {
+      threads.emplace_back([&table, &result]() {
+         for (int i = 0; i < 10; ++i) {
+            result = render_to_string(*table);
+         }
+      });
+   }
+   for (std::thread& t : threads) {
+      t.join();
+   }
+
+   for (const S& result : results) {
+      REQUIRE(result == expected);
+   }
+}
+
+#endif
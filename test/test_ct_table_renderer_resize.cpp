@@ -0,0 +1,61 @@
+#ifdef BE_TEST
+
+#include "table.hpp"
+#include "table_renderer.hpp"
+#include <catch/catch.hpp>
+#include <sstream>
+
+#define BE_CATCH_TAGS "[ct][ct:TableRenderer]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+Table make_table() {
+   TableConfig config;
+   set_border(config.box, BorderConfig { 2, 1, LogColor::current, "=" }, BorderConfig { 1, 2, LogColor::current, "|" });
+   set_border_padding(config.box, 1, 2);
+   Table t(config);
+   t << header << cell << "Name" << cell << "Description" << cell << "N";
+   for (int i = 0; i < 4; ++i) {
+      t << row << cell << "item " << i << cell << "some words that wrap around when narrow" << cell << i * 1234;
+      set_border(t.back().config().box, BorderConfig { 1, 0, LogColor::current, "-" }, BorderConfig { });
+      set_border_padding(t.back().config().box, 0, 1);
+      set_border(t.back().back().config().box, BorderConfig { }, BorderConfig { 2, 1, LogColor::current, ":" });
+   }
+   return t;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+S render_lines(detail::TableRenderer& r, I32 width) {
+   std::ostringstream os;
+   r.auto_size(width);
+   r.combine_border_corners();
+   while (r) {
+      os << nl;
+      r(os);
+   }
+   return os.str();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+S render_fresh(const Table& table, I32 width) {
+   detail::TableRenderer r(table);
+   return render_lines(r, width);
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Resizing a TableRenderer matches a fresh render at each width", BE_CATCH_TAGS) {
+   Table table = make_table();
+   detail::TableRenderer r(table);
+
+   for (I32 width : { 120, 40, 18, 12, 60, 18, 200, 30 }) {
+      REQUIRE(render_lines(r, width) == render_fresh(table, width));
+   }
+}
+
+#endif
@@ -0,0 +1,111 @@
+#ifdef BE_TEST
+
+#include "table.hpp"
+#include "table_renderer.hpp"
+#include <catch/catch.hpp>
+
+#define BE_CATCH_TAGS "[ct][ct:TableSizer]"
+
+using namespace be;
+using namespace be::ct;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The first column has one very long cell, so a proportional split
+///        gives it most of the width even though that only shortens one row,
+///        while the second column wraps in every row.
+Table make_table(F32 budget_ms, I16 min_width = 0) {
+   TableConfig config;
+   set_border(config.box, BorderConfig { 1, 1, LogColor::current, "-" }, BorderConfig { 1, 1, LogColor::current, "|" });
+   config.line_count_budget_ms = budget_ms;
+   Table t(config);
+   t << row << cell << "a single cell with a great deal of text in it, far more than any other cell in this column, or in the table"
+            << cell << "short words in every row";
+   for (int i = 0; i < 12; ++i) {
+      t << row << cell << i << cell << "short words in row " << i;
+   }
+   for (Row& r : t) {
+      for (Cell& c : r) {
+         c.config().min_width = min_width;
+      }
+   }
+   return t;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+I64 line_count(const LayoutSnapshot& snapshot) {
+   I64 lines = 0;
+   for (const RowLayout& row : snapshot.rows) {
+      lines += row.internal_height;
+   }
+   return lines;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<I32> column_widths(const LayoutSnapshot& snapshot) {
+   std::vector<I32> widths;
+   for (const ColumnLayout& col : snapshot.columns) {
+      widths.push_back(col.internal_width);
+   }
+   return widths;
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Line count solver never wraps to more lines than a proportional split", BE_CATCH_TAGS) {
+   Table proportional = make_table(0);
+   Table solved = make_table(1000);
+
+   bool fewer = false;
+   for (I32 width = 16; width <= 120; ++width) {
+      I64 proportional_lines = line_count(layout(proportional, width));
+      I64 solved_lines = line_count(layout(solved, width));
+      REQUIRE(solved_lines <= proportional_lines);
+      fewer = fewer || solved_lines < proportional_lines;
+   }
+   REQUIRE(fewer);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Line count solver chooses widths that save lines", BE_CATCH_TAGS) {
+   // With every column at least one wide, the solver's starting widths are
+   // the minimum widths, so only its greedy choices can differ from a
+   // proportional split.
+   Table proportional = make_table(0, 1);
+   Table solved = make_table(1000, 1);
+
+   I32 fewer = 0;
+   for (I32 width = 16; width <= 120; ++width) {
+      I64 proportional_lines = line_count(layout(proportional, width));
+      I64 solved_lines = line_count(layout(solved, width));
+      REQUIRE(solved_lines <= proportional_lines);
+      if (solved_lines < proportional_lines) {
+         ++fewer;
+      }
+   }
+   REQUIRE(fewer > 0);
+
+   LayoutSnapshot narrow = layout(solved, 40);
+   REQUIRE(line_count(narrow) < line_count(layout(proportional, 40)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Line count solver falls back to a proportional split when out of time", BE_CATCH_TAGS) {
+   Table proportional = make_table(0);
+   Table solved = make_table(1000);
+   Table expired = make_table(1e-9f);
+
+   bool solver_differs = false;
+   for (I32 width = 16; width <= 120; width += 8) {
+      LayoutSnapshot expected = layout(proportional, width);
+      LayoutSnapshot actual = layout(expired, width);
+      REQUIRE(column_widths(actual) == column_widths(expected));
+      REQUIRE(line_count(actual) == line_count(expected));
+      solver_differs = solver_differs || column_widths(layout(solved, width)) != column_widths(expected);
+   }
+   REQUIRE(solver_differs);
+}
+
+#endif
@@ -0,0 +1,125 @@
+#ifdef BE_TEST
+
+#include "table.hpp"
+#include "table_renderer.hpp"
+#include <catch/catch.hpp>
+#include <sstream>
+
+#define BE_CATCH_TAGS "[ct][ct:Undecorated]"
+
+using namespace be;
+using namespace be::ct;
+using namespace be::ct::detail;
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Default BoxConfigs throughout, so every level is undecorated, but
+///        with cells of different heights, mixed alignment, and colors.
+Table make_table() {
+   Table t;
+   t << header << cell << "Name" << cell << "Description" << cell << "N";
+   for (int i = 0; i < 5; ++i) {
+      t << row << cell << "item " << i
+               << cell << setcolor(LogColor::green) << "some words " << setcolor(LogColor::current, LogColor::blue) << "that wrap around when narrow"
+               << cell << i * 1234;
+      t.back().config().box.align = i % 2 == 0 ? BoxConfig::align_middle : BoxConfig::align_bottom;
+      t.back()[0].config().box.align = BoxConfig::align_right;
+      t.back()[2].config().box.align = i % 3 == 0 ? BoxConfig::align_center : BoxConfig::inherit_alignment;
+   }
+   return t;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::ostringstream make_stream() {
+   std::ostringstream os;
+   os << setcolor(LogColor::gray, LogColor::black);
+   return os;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Renders through the box's margin renderer, i.e. the path taken
+///        when the box has decorations, rather than the undecorated shortcut.
+template <typename Box>
+void render_decorated(std::ostream& os, Box& box) {
+   box.freeze();
+   for (I32 line = 0, height = box.height(); line < height; ++line) {
+      os << nl;
+      box.margin(os);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Box>
+void render_undecorated(std::ostream& os, Box& box) {
+   while (box) {
+      os << nl;
+      box(os);
+   }
+}
+
+} // ()
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Undecorated cells render the same as decorated ones", BE_CATCH_TAGS) {
+   Table table = make_table();
+
+   for (const Row& r : table) {
+      for (const Cell& c : r) {
+         for (I32 width : { 3, 8, 40 }) {
+            CellRenderer fast(c);
+            CellRenderer general(c);
+            fast.auto_size(width);
+            general.auto_size(width);
+            fast.text.height(4);
+            general.text.height(4);
+
+            std::ostringstream expected = make_stream();
+            std::ostringstream actual = make_stream();
+            render_decorated(expected, general);
+            render_undecorated(actual, fast);
+            REQUIRE(actual.str() == expected.str());
+         }
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Undecorated rows render the same as decorated ones", BE_CATCH_TAGS) {
+   Table table = make_table();
+
+   for (const Row& r : table) {
+      for (I32 width : { 12, 30, 80 }) {
+         RowRenderer fast(r);
+         RowRenderer general(r);
+         fast.auto_size(width);
+         general.auto_size(width);
+
+         std::ostringstream expected = make_stream();
+         std::ostringstream actual = make_stream();
+         render_decorated(expected, general);
+         render_undecorated(actual, fast);
+         REQUIRE(actual.str() == expected.str());
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("Undecorated tables render the same as decorated ones", BE_CATCH_TAGS) {
+   Table table = make_table();
+
+   for (I32 width : { 12, 30, 80 }) {
+      TableRenderer fast(table);
+      TableRenderer general(table);
+      fast.auto_size(width);
+      general.auto_size(width);
+
+      std::ostringstream expected = make_stream();
+      std::ostringstream actual = make_stream();
+      render_decorated(expected, general);
+      render_undecorated(actual, fast);
+      REQUIRE(actual.str() == expected.str());
+   }
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifdef BE_TEST
+
+#include "width_sketch.hpp"
+#include <catch/catch.hpp>
+
+#define BE_CATCH_TAGS "[ct][ct:WidthSketch]"
+
+using namespace be;
+using namespace be::ct;
+
+///////////////////////////////////////////////////////////////////////////////
+TEST_CASE("WidthSketch", BE_CATCH_TAGS) {
+   WidthSketch sketch;
+
+   SECTION("Empty sketch") {
+      REQUIRE(sketch.empty());
+      REQUIRE(sketch.quantile(0.5f) == 0);
+      REQUIRE(sketch.quantile(1) == 0);
+   }
+
+   SECTION("Small widths are exact") {
+      for (I32 w = 1; w <= 20; ++w) {
+         sketch.add(w);
+      }
+      REQUIRE(sketch.size() == 20);
+      REQUIRE(sketch.quantile(0) == 1);
+      REQUIRE(sketch.quantile(0.5f) == 10);
+      REQUIRE(sketch.quantile(0.95f) == 19);
+      REQUIRE(sketch.quantile(1) == 20);
+   }
+
+   SECTION("Outliers do not affect lower percentiles") {
+      for (int i = 0; i < 99; ++i) {
+         sketch.add(12);
+      }
+      sketch.add(4096);
+      REQUIRE(sketch.quantile(0.9f) == 12);
+      REQUIRE(sketch.quantile(0.99f) == 12);
+      REQUIRE(sketch.quantile(1) == 4096);
+   }
+
+   SECTION("Large widths are never underestimated, and overestimated by at most 12.5%") {
+      for (I32 w : { 32, 33, 100, 1000, 1023, 1024, 30000 }) {
+         WidthSketch s;
+         s.add(w);
+         s.add(w + 1000000);
+         I32 q = s.quantile(0.5f);
+         REQUIRE(q >= w);
+         REQUIRE(q <= w + w / 8);
+      }
+   }
+
+   SECTION("Merging") {
+      WidthSketch other;
+      for (I32 w = 1; w <= 10; ++w) {
+         sketch.add(w);
+         other.add(w + 10);
+      }
+      sketch.add(other);
+      REQUIRE(sketch.size() == 20);
+      REQUIRE(sketch.quantile(0.5f) == 10);
+      REQUIRE(sketch.quantile(1) == 20);
+   }
+}
+
+#endif